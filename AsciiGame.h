@@ -3,6 +3,8 @@
 #include "AsciiGraphics.h"
 #include "GLGraphics.h"
 #include "Game.h"
+#include "Sprite.h"
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Consts
@@ -15,19 +17,42 @@ constexpr double DEFAULT_ASCII_HEIGHT = 25;
 // GameObject definitions
 //------------------------------------------------------------------------------
 
+/** @brief Object drawn as sprite stamps; where its position lives is up to the subclass */
 template <WrapType Wrap = kWrapBoth>
-class AsciiWorldObject : public GameObject<0>
+class AsciiSpriteObject : public GameObject<0>
 {
 public:
     using Coord = ObjCoord<0>;
 
-    AsciiWorldObject(AsciiGraphics *asciiGraphics) : ascii{asciiGraphics} {};
+    AsciiSpriteObject(AsciiGraphics *asciiGraphics) : ascii{asciiGraphics} {};
 
     inline virtual void Draw() override
     {
-        DrawChars();
+        DrawStamps();
     }
 
+protected:
+    inline void DrawStamps()
+    {
+        for (const Stamp<Wrap> &stamp : stamps)
+        {
+            DrawStamp<Wrap>(*ascii, stamp);
+        }
+    }
+    // Member variables
+    std::vector<Stamp<Wrap>> stamps;
+
+    AsciiGraphics *ascii = nullptr;
+};
+
+template <WrapType Wrap = kWrapBoth>
+class AsciiWorldObject : public AsciiSpriteObject<Wrap>
+{
+public:
+    using Coord = ObjCoord<0>;
+
+    AsciiWorldObject(AsciiGraphics *asciiGraphics) : AsciiSpriteObject<Wrap>(asciiGraphics) {};
+
     inline void SetPos(Vector2<Worldspace> pos)
     {
         x = pos.x();
@@ -39,19 +64,6 @@ public:
     }
 
 protected:
-    inline void DrawChars()
-    {
-        for (uint i = 0; i < numChars; i++)
-        {
-            ascii->DrawCharPixel(chars[i]);
-        }
-    }
-    // Member variables
-    size_t numChars = 0;
-    CharPixel<Wrap> chars[MAX_CHARS];
-
-    AsciiGraphics *ascii = nullptr;
-
     WorldX<Wrap> x{0};
     WorldY<Wrap> y{0};
 };
@@ -65,9 +77,12 @@ class AsciiGame : public Game
 public:
     inline static double GET_DEFAULT_WIDTH() { return DEFAULT_ASCII_WIDTH; };
     inline static double GET_DEFAULT_HEIGHT() { return DEFAULT_ASCII_HEIGHT; };
+    // Terminal rows and columns are 1-based
+    inline static double GET_DEFAULT_ORIGIN() { return 1; };
 
     AsciiGame(AsciiGraphics *asciiGraphics) : Game(), ascii{asciiGraphics} {};
 
+    /** @brief Redraws the whole board into the back buffer; only changed cells reach the terminal */
     inline virtual void Draw() override
     {
         ascii->ClearScreen();
@@ -76,21 +91,22 @@ public:
         ascii->DrawRect(XBounds::lowerBound, YBounds::lowerBound, XBounds::width(), YBounds::height(), '.', false);
 
         // Draw objects
-        for (uint i = 0; i < MAX_GAME_OBJECTS; i++)
+        for (Entity *obj : gameObjects)
         {
-            if (gameObjects[i] != nullptr)
+            if (obj->IsEnabled())
             {
-                if (gameObjects[i]->IsEnabled())
-                {
-                    gameObjects[i]->Draw();
-                }
+                obj->Draw();
             }
         }
+        DrawOverlay();
 
         // End frame
         ascii->EndFrame();
     }
 
+    /** @brief Draw on top of the objects, e.g. a score; called before the frame is sent */
+    inline virtual void DrawOverlay() {}
+
 protected:
     AsciiGraphics *ascii;
 };
@@ -103,14 +119,12 @@ template <IsGame G>
     requires std::is_base_of_v<AsciiGame, G>
 int PlayGame()
 {
-    XBounds::SetLowerBound(1);
-    XBounds::SetUpperBound(1 + G::GET_DEFAULT_WIDTH());
-    YBounds::SetLowerBound(1);
-    YBounds::SetUpperBound(1 + G::GET_DEFAULT_HEIGHT());
+    DefaultBounds<G>().Install();
 
-    AsciiGraphics ascii{};
+    AsciiGraphics ascii{STDOUT_FILENO};
     GLGraphics glHeadless{};
     G *game = new G(&ascii);
+    WorldScope scope{*game};
 
     glHeadless.InitializeHeadless();
 
@@ -118,14 +132,8 @@ int PlayGame()
     while (1)
     {
         glHeadless.UpdateHeadless();
-        game->Update();
-        game->Draw();
-        if (KeyEventManager::GetInstance().Keydown(kKeyCodeDown))
-        {
-            std::cout << "key down" << std::endl;
-        }
-
-        usleep(1000 * 16);
+        // Nothing else may write to the terminal here: it would desync the renderer's front buffer
+        game->Tick();
     }
     return 0;
 }
\ No newline at end of file
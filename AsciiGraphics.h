@@ -1,8 +1,16 @@
 #pragma once
 #include "UnitLib/Unit.h"
 #include "Game.h"
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Consts
@@ -11,6 +19,13 @@
 const uint BUF_SIZE = 2048;
 const uint ESC_SIZE = 32;
 const uint MAX_WIDTH = 1024;
+const uint MAX_HEIGHT = 1024;
+/** @brief Unchanged cells rewritten rather than skipped with a cursor move, at most */
+const uint MAX_GAP_FILL = 4;
+/** @brief Bytes one cell can take in a frame, at most: a cursor move, an SGR transition and a 4-byte glyph */
+const uint MAX_CELL_BYTES = 32;
+/** @brief Bytes a frame can take besides its cells: the initial clear and the final cursor park */
+const uint FRAME_OVERHEAD_BYTES = 16;
 
 enum TextAttribute
 {
@@ -22,6 +37,7 @@ enum TextAttribute
 
 enum FGColor
 {
+    kFGDefault = 0,
     kFGBlack = 30,
     kFGRed = 31,
     kFGGreen = 32,
@@ -45,6 +61,44 @@ enum BGColor
     kBGWhite = 47
 };
 
+//------------------------------------------------------------------------------
+// Escape tables
+//------------------------------------------------------------------------------
+
+/** @brief Decimal text of a number, for building escapes without formatting */
+struct EscNumber
+{
+    char text[4];
+    uint8_t len;
+};
+
+/** @brief Decimal text of 0 to MAX_WIDTH, which covers every row, column and SGR code */
+inline constexpr std::array<EscNumber, MAX_WIDTH + 1> ESC_NUMBERS = []()
+{
+    std::array<EscNumber, MAX_WIDTH + 1> numbers{};
+    for (uint i = 0; i <= MAX_WIDTH; i++)
+    {
+        char digits[4];
+        uint len = 0;
+        for (uint v = i; len == 0 || v > 0; v /= 10)
+        {
+            digits[len++] = static_cast<char>('0' + v % 10);
+        }
+        for (uint k = 0; k < len; k++)
+        {
+            numbers[i].text[k] = digits[len - 1 - k];
+        }
+        numbers[i].len = static_cast<uint8_t>(len);
+    }
+    return numbers;
+}();
+
+/** @brief SGR parameters turning a TextAttribute on and off, indexed by the attribute */
+inline constexpr const char *SGR_ATTRIBUTE_ON[8] = {"", "1", "", "", "4", "", "", "7"};
+inline constexpr const char *SGR_ATTRIBUTE_OFF[8] = {"", "22", "", "", "24", "", "", "27"};
+constexpr int SGR_FG_DEFAULT = 39;
+constexpr int SGR_BG_DEFAULT = 49;
+
 //------------------------------------------------------------------------------
 // CharPixel definition
 //------------------------------------------------------------------------------
@@ -56,7 +110,6 @@ struct CharPixel
     WorldY<Wrap> y;
     char pix;
 };
-const size_t MAX_CHARS = 256;
 
 template <typename T>
 concept IsCharPixel = requires(T t) {
@@ -65,41 +118,160 @@ concept IsCharPixel = requires(T t) {
     { t.pix } -> std::convertible_to<char>;
 };
 
+//------------------------------------------------------------------------------
+// Null output
+//------------------------------------------------------------------------------
+
+/** @brief Stream buffer that discards everything written to it */
+class NullStreamBuf : public std::streambuf
+{
+protected:
+    int_type overflow(int_type c) override
+    {
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char *, std::streamsize n) override
+    {
+        return n;
+    }
+};
+
+/** @brief Output stream that discards everything; a null backend for AsciiGraphics */
+class NullOStream : public std::ostream
+{
+public:
+    NullOStream() : std::ostream(nullptr)
+    {
+        rdbuf(&buf);
+    }
+
+private:
+    NullStreamBuf buf;
+};
+
+//------------------------------------------------------------------------------
+// Cell definitions
+//------------------------------------------------------------------------------
+
+/** @brief Colors and attribute a cell is drawn with */
+struct TextStyle
+{
+    int8_t attribute = kTextNormal;
+    int8_t fg = kFGDefault;
+    int8_t bg = kBGNone;
+
+    bool operator==(const TextStyle &) const = default;
+};
+
+/** @brief One terminal cell: a UTF-8 glyph and its style */
+struct Cell
+{
+    /** @brief UTF-8 bytes of the glyph, first byte lowest; 0 marks the right half of a wide glyph */
+    uint32_t glyph = ' ';
+    TextStyle style{};
+    /** @brief Columns the glyph covers: 1, or 2 for wide glyphs such as emoji */
+    uint8_t width = 1;
+
+    bool operator==(const Cell &) const = default;
+
+    inline bool IsContinuation() const
+    {
+        return glyph == 0;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Render statistics
+//------------------------------------------------------------------------------
+
+/** @brief Output cost of AsciiGraphics, accumulated over frames */
+struct RenderStats
+{
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    /** @brief write(2) calls made; always 0 when rendering to an ostream */
+    uint64_t syscalls = 0;
+    uint64_t lastFrameBytes = 0;
+
+    inline double BytesPerFrame() const
+    {
+        return frames > 0 ? static_cast<double>(bytes) / frames : 0;
+    }
+
+    inline double SyscallsPerFrame() const
+    {
+        return frames > 0 ? static_cast<double>(syscalls) / frames : 0;
+    }
+};
+
 //------------------------------------------------------------------------------
 // AsciiGraphics definition
 //------------------------------------------------------------------------------
 
+/**
+ * @brief Terminal renderer backed by a cell framebuffer.
+ * - Drawing calls only write cells of a back buffer, in the current style
+ *   (SetTextColor/ResetTextColor); nothing reaches the terminal until EndFrame
+ * - EndFrame compares the back buffer with the front buffer, the cells the
+ *   terminal is known to show, and emits only the cells that changed: short
+ *   unchanged gaps are rewritten, longer ones skipped with the shortest cursor
+ *   motion
+ * - Changed cells are emitted grouped by style, and the terminal's current
+ *   style is tracked across frames, so an SGR escape is emitted only on an
+ *   actual transition, as the shorter of a reset or the changed parameters
+ * - Escapes are assembled from precomputed tables, never formatted
+ * - Escapes and glyphs go straight into a frame arena sized for the worst
+ *   case, so emitting never checks capacity or reallocates. The frame is
+ *   submitted with a single write(2) to a file descriptor, retried only if
+ *   the kernel takes part of it, or to an ostream (e.g. an ostringstream in
+ *   tests) with one write and one flush. Frames with no changes are not
+ *   submitted at all
+ *
+ * Coordinates are 1-based terminal rows and columns, as with raw escapes; 0 is
+ * treated as 1. The buffers grow to fit whatever is drawn.
+ *
+ * The renderer assumes it is the only writer to its terminal. Output from
+ * anywhere else moves the cursor and overwrites cells behind its back; call
+ * Invalidate() afterwards to repaint.
+ */
 class AsciiGraphics
 {
 public:
     /** @brief Constructor, takes and stores an ostream */
     AsciiGraphics(std::ostream &oss = std::cout) : os(&oss) {};
 
-    /** @brief Clears the screen */
+    /** @brief Render straight to a file descriptor such as STDOUT_FILENO, bypassing iostreams */
+    explicit AsciiGraphics(int fd_) : fd(fd_) {};
+
+    /** @brief Clears the back buffer to blank cells */
     void ClearScreen()
     {
-        const char *CLEAR_SCREEN = "\033[2J";
-        os->write(CLEAR_SCREEN, strlen(CLEAR_SCREEN));
+        std::fill(back.begin(), back.end(), Cell{});
     }
 
-    /** @brief Moves the cursor to the position specified by x, y */
+    /** @brief Forget what the terminal shows, so the next frame clears it and repaints everything */
+    void Invalidate()
+    {
+        fullRedraw = true;
+    }
+
+    /** @brief Moves the draw cursor to the position specified by x, y */
     void MoveCursor(const uint &x, const uint &y)
     {
-        size_t n = snprintf(escBuf, BUF_SIZE, "\033[%d;%dH", y, x);
-        os->write(escBuf, n);
+        drawCol = ToIndex_(x);
+        drawRow = ToIndex_(y);
     }
 
-    /** @brief Writes text to the current cursor position */
+    /** @brief Writes UTF-8 text at the draw cursor, advancing it */
     void Write(const std::string &text)
     {
-        os->write(text.c_str(), text.size());
+        WriteText_(text.data(), text.size());
     }
 
     /** @brief Draws the character `char` to x, y */
     void DrawChar(const uint &x, const uint &y, const char &fill)
     {
-        MoveCursor(x, y);
-        os->put(fill);
+        PutCell_(ToIndex_(x), ToIndex_(y), static_cast<unsigned char>(fill), 1);
     }
 
     /** @brief Draw a char pixel. Enforces Worldspace */
@@ -109,77 +281,551 @@ public:
         DrawChar(charPixel.x.GetValue(), charPixel.y.GetValue(), charPixel.pix);
     }
 
+    /** @brief Draws `length` copies of `fill` from x, y rightwards */
+    void DrawSpan(const uint &x, const uint &y, const uint &length, const char &fill)
+    {
+        FillRun_(ToIndex_(x), ToIndex_(y), length, static_cast<unsigned char>(fill));
+    }
+
     /** @brief Draws the text `str` to x, y */
     void DrawText(const Worldspace x, const Worldspace y, const char *str)
     {
         MoveCursor(x.GetValue(), y.GetValue());
-        os->write(str, strlen(str));
+        WriteText_(str, strlen(str));
     }
 
     /** @brief Draws a rectangle (filled or not) using the given character */
     void DrawRect(const uint &x, const uint &y, const uint &width, const uint &height, const char &fill = '.', const bool filled = true)
     {
         assert(width < MAX_WIDTH);
-        std::fill_n(rowBuf, width, fill);
+        uint32_t glyph = static_cast<unsigned char>(fill);
+        uint col = ToIndex_(x);
+        uint row = ToIndex_(y);
 
         for (uint i = 0; i < height; i++)
         {
-            MoveCursor(x, y + i);
-
-            if (filled)
+            if (filled || i == 0 || i == height - 1)
             {
-                os->write(rowBuf, width);
+                FillRun_(col, row + i, width, glyph);
             }
             else
             {
-                if (i == 0 || i == height - 1)
+                PutCell_(col, row + i, glyph, 1);
+                PutCell_(col + width - 1, row + i, glyph, 1);
+            }
+        }
+    }
+
+    /** @brief Style of subsequent drawing */
+    void SetTextColor(FGColor fg, BGColor bg = kBGNone, TextAttribute attribute = kTextNormal)
+    {
+        pen = {static_cast<int8_t>(attribute), static_cast<int8_t>(fg), static_cast<int8_t>(bg)};
+    }
+
+    void ResetTextColor()
+    {
+        pen = TextStyle{};
+    }
+
+    /** @brief End a frame - writes the changed cells in one go, flushes and parks the cursor at 1, 1 */
+    void EndFrame()
+    {
+        size_t capacity = static_cast<size_t>(cols) * rows * MAX_CELL_BYTES + FRAME_OVERHEAD_BYTES;
+        if (arena.size() < capacity)
+        {
+            arena.resize(capacity);
+        }
+        out = arena.data();
+
+        if (fullRedraw)
+        {
+            // After a clear the terminal shows blank cells in the default style
+            Put_("\033[0m\033[2J");
+            std::fill(front.begin(), front.end(), Cell{});
+            termStyle = TextStyle{};
+            termRow = termCol = UNKNOWN;
+            fullRedraw = false;
+        }
+
+        MarkDirty_();
+        for (const TextStyle &style : styles)
+        {
+            for (uint row : dirtyRows)
+            {
+                EmitRow_(row, style);
+            }
+        }
+
+        if (termRow != 0 || termCol != 0)
+        {
+            Put_("\033[H");
+            termRow = termCol = 0;
+        }
+        front = back;
+
+        size_t size = out - arena.data();
+        assert(size <= arena.size());
+        stats.frames++;
+        stats.bytes += size;
+        stats.lastFrameBytes = size;
+        if (size > 0)
+        {
+            Submit_(arena.data(), size);
+        }
+    }
+
+    inline const RenderStats &GetRenderStats() const
+    {
+        return stats;
+    }
+
+    inline void ResetRenderStats()
+    {
+        stats = RenderStats{};
+    }
+
+    /** @brief The cell at x, y of the back buffer, or a blank cell outside it */
+    Cell GetCell(const uint &x, const uint &y) const
+    {
+        uint col = ToIndex_(x);
+        uint row = ToIndex_(y);
+        return col < cols && row < rows ? back[row * cols + col] : Cell{};
+    }
+
+private:
+    inline static constexpr uint UNKNOWN = UINT32_MAX;
+
+    inline static uint ToIndex_(double coord)
+    {
+        return coord >= 1 ? static_cast<uint>(coord) - 1 : 0;
+    }
+
+    /** @brief Columns a code point covers in a terminal: 2 for CJK and emoji, else 1 */
+    inline static uint8_t GlyphWidth_(uint32_t cp)
+    {
+        bool wide = (cp >= 0x1100 && cp <= 0x115F) || (cp >= 0x2E80 && cp <= 0xA4CF) ||
+                    (cp >= 0xAC00 && cp <= 0xD7A3) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+                    (cp >= 0xFE30 && cp <= 0xFE4F) || (cp >= 0xFF00 && cp <= 0xFF60) ||
+                    (cp >= 0xFFE0 && cp <= 0xFFE6) || (cp >= 0x1F300 && cp <= 0x1FAFF) ||
+                    (cp >= 0x20000 && cp <= 0x3FFFD);
+        return wide ? 2 : 1;
+    }
+
+    /** @brief Split UTF-8 text into glyphs and draw them from the draw cursor on */
+    inline void WriteText_(const char *text, size_t n)
+    {
+        size_t i = 0;
+        while (i < n)
+        {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            size_t len = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+            len = std::min(len, n - i);
+
+            uint32_t glyph = 0;
+            uint32_t cp = len == 1 ? lead : lead & (0x3F >> (len - 1));
+            for (size_t k = 0; k < len; k++)
+            {
+                unsigned char byte = static_cast<unsigned char>(text[i + k]);
+                glyph |= static_cast<uint32_t>(byte) << (8 * k);
+                if (k > 0)
                 {
-                    os->write(rowBuf, width);
+                    cp = (cp << 6) | (byte & 0x3F);
                 }
-                else
+            }
+
+            uint8_t width = GlyphWidth_(cp);
+            PutCell_(drawCol, drawRow, glyph, width);
+            drawCol += width;
+            i += len;
+        }
+    }
+
+    /** @brief Set a cell of the back buffer in the current style, keeping wide glyphs whole */
+    inline void PutCell_(uint col, uint row, uint32_t glyph, uint8_t width)
+    {
+        if (col + width > MAX_WIDTH || row >= MAX_HEIGHT)
+        {
+            return;
+        }
+        Grow_(col + width, row + 1);
+
+        Cell *line = &back[row * cols];
+        // Overwriting half of a wide glyph blanks the other half, as terminals do
+        for (uint c = col; c < col + width; c++)
+        {
+            if (line[c].IsContinuation() && c > 0)
+            {
+                line[c - 1] = Cell{' ', line[c - 1].style};
+            }
+            if (line[c].width == 2 && c + 1 < cols)
+            {
+                line[c + 1] = Cell{' ', line[c].style};
+            }
+        }
+
+        line[col] = Cell{glyph, pen, width};
+        if (width == 2)
+        {
+            line[col + 1] = Cell{0, pen, 0};
+        }
+    }
+
+    /** @brief Set `length` cells from col, row to a narrow glyph in the current style */
+    inline void FillRun_(uint col, uint row, uint length, uint32_t glyph)
+    {
+        if (row >= MAX_HEIGHT || col >= MAX_WIDTH)
+        {
+            return;
+        }
+        length = std::min(length, MAX_WIDTH - col);
+        if (length == 0)
+        {
+            return;
+        }
+        Grow_(col + length, row + 1);
+
+        // Only the ends can cut a wide glyph in half; blank its other half, as in PutCell_
+        Cell *line = &back[row * cols];
+        uint end = col + length;
+        if (line[col].IsContinuation() && col > 0)
+        {
+            line[col - 1] = Cell{' ', line[col - 1].style};
+        }
+        if (line[end - 1].width == 2 && end < cols)
+        {
+            line[end] = Cell{' ', line[end - 1].style};
+        }
+        std::fill(line + col, line + end, Cell{glyph, pen, 1});
+    }
+
+    /** @brief Make both buffers at least `newCols` x `newRows`; new cells are blank, as on a cleared screen */
+    inline void Grow_(uint newCols, uint newRows)
+    {
+        if (newCols <= cols && newRows <= rows)
+        {
+            return;
+        }
+        newCols = std::max(newCols, cols);
+        newRows = std::max(newRows, rows);
+
+        auto Regrid = [&](std::vector<Cell> &cells)
+        {
+            std::vector<Cell> grown(newCols * newRows);
+            for (uint row = 0; row < rows; row++)
+            {
+                std::copy_n(&cells[row * cols], cols, &grown[row * newCols]);
+            }
+            cells.swap(grown);
+        };
+        Regrid(back);
+        Regrid(front);
+        cols = newCols;
+        rows = newRows;
+        dirty.resize(cols * rows);
+    }
+
+    /** @brief Find the cells to emit, the rows holding them, and their distinct styles */
+    inline void MarkDirty_()
+    {
+        dirtyRows.clear();
+        styles.clear();
+        for (uint row = 0; row < rows; row++)
+        {
+            const Cell *next = &back[row * cols];
+            const Cell *shown = &front[row * cols];
+            uint8_t *mark = &dirty[row * cols];
+
+            bool any = false;
+            for (uint col = 0; col < cols; col++)
+            {
+                mark[col] = !(next[col] == shown[col]);
+                any |= mark[col];
+            }
+            if (!any)
+            {
+                continue;
+            }
+            dirtyRows.push_back(row);
+
+            // A changed half of a wide glyph, old or new, means redrawing the whole glyph and its neighbour
+            for (uint col = 0; col + 1 < cols; col++)
+            {
+                if (mark[col] && (next[col].width == 2 || shown[col].width == 2))
+                {
+                    mark[col + 1] = true;
+                }
+            }
+            for (uint col = cols - 1; col > 0; col--)
+            {
+                if (mark[col] && (next[col].IsContinuation() || shown[col].IsContinuation()))
                 {
-                    os->put(fill);
-                    MoveCursor(x + width - 1, y + i);
-                    os->put(fill);
+                    mark[col - 1] = true;
+                }
+            }
+
+            for (uint col = 0; col < cols; col++)
+            {
+                if (mark[col] && std::find(styles.begin(), styles.end(), next[col].style) == styles.end())
+                {
+                    styles.push_back(next[col].style);
                 }
             }
         }
+
+        // Start with the style the terminal is already in
+        auto current = std::find(styles.begin(), styles.end(), termStyle);
+        if (current != styles.end())
+        {
+            std::rotate(styles.begin(), current, current + 1);
+        }
     }
 
-    void SetTextColor(FGColor fg, BGColor bg = kBGNone, TextAttribute attribute = kTextNormal)
+    /** @brief Append the changed cells of one row drawn in `style` */
+    inline void EmitRow_(uint row, const TextStyle &style)
+    {
+        const Cell *next = &back[row * cols];
+        const uint8_t *mark = &dirty[row * cols];
+
+        for (uint col = 0; col < cols; col++)
+        {
+            if (!mark[col] || next[col].IsContinuation() || !(next[col].style == style))
+            {
+                continue;
+            }
+
+            if (termRow != row || termCol > col || !FillGap_(next, termCol, col))
+            {
+                MoveTo_(row, col);
+            }
+            EmitCell_(next[col]);
+            termCol = col + next[col].width;
+        }
+
+        // The terminal may be holding a pending wrap at the right edge; don't rely on where the cursor is
+        if (termRow == row && termCol >= cols)
+        {
+            termRow = termCol = UNKNOWN;
+        }
+    }
+
+    /** @brief Rewrite unchanged cells [from, to) if that is shorter than moving past them */
+    inline bool FillGap_(const Cell *next, uint from, uint to)
+    {
+        if (to - from > MAX_GAP_FILL)
+        {
+            return false;
+        }
+        for (uint col = from; col < to; col++)
+        {
+            if (!(next[col].style == termStyle) || next[col].IsContinuation() || col + next[col].width > to)
+            {
+                return false;
+            }
+        }
+        for (uint col = from; col < to; col++)
+        {
+            AppendGlyph_(next[col].glyph);
+        }
+        return true;
+    }
+
+    /** @brief Move the terminal cursor; forward along the same row, CUF is never longer than CUP */
+    inline void MoveTo_(uint row, uint col)
+    {
+        Put_("\033[");
+        if (termRow == row && termCol < col)
+        {
+            AppendNumber_(col - termCol);
+            Put_('C');
+        }
+        else
+        {
+            // Omitted parameters default to 1
+            if (row != 0 || col != 0)
+            {
+                AppendNumber_(row + 1);
+            }
+            if (col != 0)
+            {
+                Put_(';');
+                AppendNumber_(col + 1);
+            }
+            Put_('H');
+        }
+        termRow = row;
+        termCol = col;
+    }
+
+    inline void EmitCell_(const Cell &cell)
     {
+        if (!(cell.style == termStyle))
+        {
+            EmitStyle_(cell.style);
+        }
+        AppendGlyph_(cell.glyph);
+    }
 
-        size_t n;
-        if (bg != kBGNone)
+    /** @brief Switch the terminal from termStyle to `style`, by changing only what differs or by a reset, whichever is shorter */
+    inline void EmitStyle_(const TextStyle &style)
+    {
+        char change[ESC_SIZE];
+        size_t changeLen = 0;
+        if (style.attribute != termStyle.attribute)
+        {
+            AppendParam_(change, changeLen, SGR_ATTRIBUTE_OFF[termStyle.attribute]);
+            AppendParam_(change, changeLen, SGR_ATTRIBUTE_ON[style.attribute]);
+        }
+        if (style.fg != termStyle.fg)
         {
-            n = snprintf(escBuf, BUF_SIZE, "\033[%d;%d;%dm", attribute, fg, bg);
+            AppendParam_(change, changeLen, style.fg == kFGDefault ? SGR_FG_DEFAULT : style.fg);
+        }
+        if (style.bg != termStyle.bg)
+        {
+            AppendParam_(change, changeLen, style.bg == kBGNone ? SGR_BG_DEFAULT : style.bg);
+        }
+
+        char reset[ESC_SIZE];
+        size_t resetLen = 0;
+        AppendParam_(reset, resetLen, 0);
+        AppendParam_(reset, resetLen, SGR_ATTRIBUTE_ON[style.attribute]);
+        if (style.fg != kFGDefault)
+        {
+            AppendParam_(reset, resetLen, style.fg);
+        }
+        if (style.bg != kBGNone)
+        {
+            AppendParam_(reset, resetLen, style.bg);
+        }
+
+        Put_("\033[");
+        if (changeLen <= resetLen)
+        {
+            Put_(change, changeLen);
         }
         else
         {
-            n = snprintf(escBuf, BUF_SIZE, "\033[%d;%dm", attribute, fg);
+            Put_(reset, resetLen);
         }
-        os->write(escBuf, n);
+        Put_('m');
+        termStyle = style;
     }
 
-    void ResetTextColor()
+    /** @brief Append an SGR parameter to `buf`, after a ';' unless it is the first */
+    inline static void AppendParam_(char *buf, size_t &len, const char *param)
     {
-        const char *RESET_TEXT = "\033[0m";
-        os->write(RESET_TEXT, strlen(RESET_TEXT));
+        if (*param == '\0')
+        {
+            return;
+        }
+        if (len > 0)
+        {
+            buf[len++] = ';';
+        }
+        for (; *param != '\0'; param++)
+        {
+            buf[len++] = *param;
+        }
     }
 
-    /** @brief End a frame - flushes the output stream and resets cursor pos */
-    void EndFrame()
+    inline static void AppendParam_(char *buf, size_t &len, int param)
     {
-        MoveCursor(0, 0);
-        os->flush();
+        const EscNumber &number = ESC_NUMBERS[param];
+        if (len > 0)
+        {
+            buf[len++] = ';';
+        }
+        std::copy_n(number.text, number.len, buf + len);
+        len += number.len;
     }
 
-private:
-    // Shared buffers useable by many functions
-    // char buf[BUF_SIZE];
-    char escBuf[ESC_SIZE];
-    char rowBuf[MAX_WIDTH];
+    inline void AppendNumber_(uint value)
+    {
+        const EscNumber &number = ESC_NUMBERS[value];
+        Put_(number.text, number.len);
+    }
+
+    inline void AppendGlyph_(uint32_t glyph)
+    {
+        do
+        {
+            Put_(static_cast<char>(glyph & 0xFF));
+            glyph >>= 8;
+        } while (glyph != 0);
+    }
+
+    // Writes into the arena; EndFrame sized it for the whole frame, so these never check
+    inline void Put_(char c)
+    {
+        *out++ = c;
+    }
+
+    inline void Put_(const char *text, size_t n)
+    {
+        out = std::copy_n(text, n, out);
+    }
+
+    template <size_t N>
+    inline void Put_(const char (&text)[N])
+    {
+        Put_(text, N - 1);
+    }
 
-    // Underlying ostream of this AsciiGraphics
+    /** @brief Hand a finished frame to the fd or the ostream */
+    inline void Submit_(const char *data, size_t n)
+    {
+        if (fd < 0)
+        {
+            os->write(data, n);
+            os->flush();
+            return;
+        }
+
+        while (n > 0)
+        {
+            ssize_t written = ::write(fd, data, n);
+            stats.syscalls++;
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                // Part of the frame never arrived, so the front buffer is wrong; repaint everything next frame
+                Invalidate();
+                return;
+            }
+            data += written;
+            n -= static_cast<size_t>(written);
+        }
+    }
+
+    // Back buffer being drawn, and what the terminal shows, row-major
+    std::vector<Cell> back;
+    std::vector<Cell> front;
+    uint cols = 0;
+    uint rows = 0;
+    // Per-frame scratch: cells to emit, rows holding them, and their styles in emission order
+    std::vector<uint8_t> dirty;
+    std::vector<uint> dirtyRows;
+    std::vector<TextStyle> styles;
+
+    // Drawing state
+    TextStyle pen{};
+    uint drawCol = 0;
+    uint drawRow = 0;
+
+    // Terminal state as of the bytes emitted so far
+    TextStyle termStyle{};
+    uint termRow = UNKNOWN;
+    uint termCol = UNKNOWN;
+    bool fullRedraw = true;
+
+    // Bytes of the frame being emitted, and the write position in them
+    std::vector<char> arena;
+    char *out = nullptr;
+    RenderStats stats;
+
+    // Output: the fd if there is one, else the ostream
+    int fd = -1;
     std::ostream *os = nullptr;
-};
\ No newline at end of file
+};
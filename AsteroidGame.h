@@ -1,7 +1,9 @@
 #pragma once
 
 #include "AsciiGame.h"
+#include "SpatialHash.h"
 #include "UnitLib/Print.h"
+#include "UnitLib/VectorMath.h"
 
 /**
  * Various game object implementatinos
@@ -67,11 +69,11 @@ private:
     }
 };
 
-class Asteroid : public AsciiWorldObject<kWrapBoth>
+class Asteroid : public AsciiSpriteObject<kWrapBoth>
 {
 public:
-    Asteroid(AsciiGraphics *asciiGraphics, double radius_)
-        : AsciiWorldObject(asciiGraphics), radius(radius_) {};
+    Asteroid(AsciiGraphics *asciiGraphics, KinematicStore<kWrapBoth> &kinematics, double radius_)
+        : AsciiSpriteObject(asciiGraphics), body(kinematics), radius(radius_) {};
 
     Child<Orbiter> *o1 = nullptr;
     Child<Orbiter>::Child<Orbiter> *o2 = nullptr;
@@ -86,12 +88,9 @@ public:
         o2->rotSpeed = 0.03;
     }
 
+    // Position/velocity are integrated in batch by the game
     inline virtual void Update() override
     {
-        vel += acc * 1_frame;
-        x += vel.x() * 1_frame;
-        y += vel.y() * 1_frame;
-
         radius *= 0.995;
         if (radius < 0.5_ws)
         {
@@ -100,28 +99,33 @@ public:
 
         GameObject<>::Update();
     }
+
+    /** @brief A spent asteroid leaves the store, so the batched integration skips it */
+    inline virtual void OnDisable() override
+    {
+        body.Release();
+    }
+
     inline virtual void Draw() override
     {
+        stamps.clear();
         if (!IsEnabled())
         {
-            numChars = 0;
             return;
         }
 
-        numChars = 0;
-
-        DrawCircle(x, y, radius);
-        ascii->ResetTextColor();
+        WorldX<kWrapBoth> cx = body.X();
+        WorldY<kWrapBoth> cy = body.Y();
+        StampCircle(cx, cy, radius);
 
         Vector2<Worldspace> wv = o1->GetWorldpos();
-        DrawCircle(x + wv.x(), y + wv.y(), o1->radius);
+        StampCircle(cx + wv.x(), cy + wv.y(), o1->radius);
 
         Vector2<Worldspace> wv2 = o2->GetWorldpos();
-        DrawCircle(x + wv2.x(), y + wv2.y(), o2->radius);
+        StampCircle(cx + wv2.x(), cy + wv2.y(), o2->radius);
 
-        // Flush chars
         ascii->SetTextColor(kFGRed, kBGNone, kTextBold);
-        DrawChars();
+        DrawStamps();
         ascii->ResetTextColor();
     }
 
@@ -132,31 +136,42 @@ public:
             return false;
         }
 
-        bool c0 = (NormSquared(point - GetPos()) <= radius * radius);
-        bool c1 = (NormSquared(point - o1->GetWorldpos()) <= o1->radius * o1->radius);
-        bool c2 = (NormSquared(point - o2->GetWorldpos()) <= o2->radius * o2->radius);
+        // Offsets go across the seam, so the asteroid can hit things on the far side of the screen
+        bool c0 = (NormSquared(WrappedOffset<kWrapBoth>(GetPos(), point)) <= radius * radius);
+        bool c1 = (NormSquared(WrappedOffset<kWrapBoth>(o1->GetWorldpos(), point)) <= o1->radius * o1->radius);
+        bool c2 = (NormSquared(WrappedOffset<kWrapBoth>(o2->GetWorldpos(), point)) <= o2->radius * o2->radius);
 
         return c0 || c1 || c2;
     };
 
+    /** @brief Radius around GetPos() that encloses the asteroid and its orbiters */
+    inline Worldspace BoundingRadius()
+    {
+        Vector2<Worldspace> center = GetPos();
+        Worldspace r1 = Norm(o1->GetWorldpos() - center) + o1->radius;
+        Worldspace r2 = Norm(o2->GetWorldpos() - center) + o2->radius;
+        return std::max({Worldspace{radius}, r1, r2});
+    }
+
+    inline Vector2<Coord> GetPos() override
+    {
+        return body.GetPos();
+    }
+
+    /** @brief Position and velocity live in the game's kinematic store, behind this body */
+    inline KinematicBody<kWrapBoth> &GetBody()
+    {
+        return body;
+    }
+
 private:
-    inline void DrawCircle(WorldX<kWrapBoth> cx, WorldY<kWrapBoth> cy, Worldspace rad)
+    /** @brief Queue a disc of '.' for this frame; the raster comes from the sprite cache */
+    inline void StampCircle(WorldX<kWrapBoth> cx, WorldY<kWrapBoth> cy, Worldspace rad)
     {
-        for (Worldspace offX = -rad; offX <= rad; offX++)
-        {
-            for (Worldspace offY = -rad; offY <= rad; offY++)
-            {
-                if (NormSquared(Vector2<Worldspace>{offX, offY}) <= rad * rad)
-                {
-                    chars[numChars++] = {
-                        .x = cx + offX,
-                        .y = cy + offY,
-                        .pix = '.'};
-                }
-            }
-        }
+        stamps.push_back({cx, cy, &SpriteCache::Circle(rad.GetValue()), '.'});
     }
 
+    KinematicBody<kWrapBoth> body;
     Coord radius;
 };
 
@@ -232,15 +247,25 @@ public:
 
     double points = 0;
 
+    SpatialHash<kWrapBoth> broadphase{};
+
     inline virtual void Initialize() override
     {
-        asteroid = CreateGameObject<Asteroid>(ascii, 2);
-        asteroid->SetVel({fRand(-0.2, 0.2), fRand(-0.2, 0.2)});
+        SpawnAsteroid();
         player = CreateGameObject<Player>(ascii);
 
         player->SetPos({GET_DEFAULT_WIDTH() / 2, GET_DEFAULT_HEIGHT() / 2});
     }
 
+    inline void SpawnAsteroid()
+    {
+        asteroid = CreateGameObject<Asteroid>(ascii, GetKinematics<kWrapBoth>(), 2);
+
+        double vel[2];
+        rng.Fill(vel, -0.2, 0.2);
+        asteroid->GetBody().SetVel({vel[0], vel[1]});
+    }
+
     inline virtual void UpdateEnd() override
     {
         if (!gameOver)
@@ -249,23 +274,30 @@ public:
         }
         if (!asteroid->IsEnabled())
         {
-            asteroid = CreateGameObject<Asteroid>(ascii, 2);
-            asteroid->SetVel({fRand(-0.2, 0.2), fRand(-0.2, 0.2)});
+            // Recycle the spent asteroid's pool slot for its replacement
+            DestroyGameObject(asteroid);
+            SpawnAsteroid();
         }
 
-        if (asteroid->Collide(player->GetPos()))
+        // Broadphase: only asteroids whose bounds contain the player get an exact test
+        broadphase.Clear();
+        if (asteroid->IsEnabled())
         {
-            player->Disable();
-            // asteroid->Disable();
-            gameOver = true;
+            broadphase.Insert(asteroid->GetHandle(), asteroid->GetPos(), asteroid->BoundingRadius());
         }
+
+        Vector2<Worldspace> playerPos = player->GetPos();
+        broadphase.QueryPoint(playerPos, [this, &playerPos](Handle handle)
+                              {
+                                  if (GetGameObject<Asteroid>(handle)->Collide(playerPos))
+                                  {
+                                      player->Disable();
+                                      gameOver = true;
+                                  } });
     }
 
-    inline virtual void Draw() override
+    inline virtual void DrawOverlay() override
     {
-        AsciiGame::Draw();
-
-
         if (gameOver)
         {
             ascii->SetTextColor(kFGRed, kBGYellow, kTextBold);
@@ -274,8 +306,6 @@ public:
         }
 
         ascii->MoveCursor(0, 0);
-        std::cout << "Points: " << (int) points;
-
-        ascii->EndFrame();
+        ascii->Write("Points: " + std::to_string((int)points));
     }
 };
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "HandleTable.h"
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// EntityPool definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Pooled store for polymorphic objects deriving from `Base`.
+ * - Creation pops a slot off the HandleTable free list (O(1), no scan)
+ * - Every object is addressable through a generational Handle, so stale handles
+ *   resolve to `nullptr` instead of a recycled object
+ * - Live objects are kept in a dense array, so iteration cost matches the live
+ *   count rather than `Capacity`
+ * - Each slot keeps the raw memory block of the object it last held. A new
+ *   object reuses that block when it fits, so steady-state churn (destroy an
+ *   object, create another of the same type) never touches the global allocator.
+ *
+ * `Base` must have a virtual destructor and a `Handle handle` member that the
+ * pool can write to (i.e. it befriends EntityPool).
+ *
+ * Objects must not be destroyed while iterating over the pool, since removal
+ * swaps the last live object into the vacated position. Creating objects while
+ * iterating is fine: they are appended to the end of the dense array, which
+ * never reallocates because its capacity is reserved up front.
+ */
+template <typename Base, size_t Capacity>
+class EntityPool
+{
+public:
+    EntityPool()
+    {
+        table.Reserve(Capacity);
+        blocks.reserve(Capacity);
+        dense.reserve(Capacity);
+    }
+
+    ~EntityPool()
+    {
+        Clear();
+        for (Block &block : blocks)
+        {
+            ::operator delete(block.memory);
+        }
+    }
+
+    EntityPool(const EntityPool &) = delete;
+    EntityPool &operator=(const EntityPool &) = delete;
+
+    /** @brief Construct a new object in the pool. Throws if the pool is full */
+    template <typename T, typename... Args>
+        requires std::is_base_of_v<Base, T> &&
+                 std::is_constructible_v<T, Args...>
+    inline T *Create(Args &&...argList)
+    {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned entities are not supported");
+
+        if (dense.size() >= Capacity)
+        {
+            throw std::runtime_error("Too many game objects!");
+        }
+
+        Handle handle = table.Allocate();
+        if (handle.index >= blocks.size())
+        {
+            blocks.push_back({});
+        }
+
+        T *obj;
+        try
+        {
+            Block &block = blocks[handle.index];
+            if (block.capacity < sizeof(T))
+            {
+                void *memory = ::operator new(sizeof(T));
+                ::operator delete(block.memory);
+                block.memory = memory;
+                block.capacity = sizeof(T);
+            }
+            obj = new (block.memory) T(std::forward<Args>(argList)...);
+        }
+        catch (...)
+        {
+            table.Free(handle);
+            throw;
+        }
+
+        obj->handle = handle;
+        dense.push_back(obj);
+        return obj;
+    }
+
+    /** @brief Destroy the object referred to by `handle`. Stale handles are ignored */
+    inline void Destroy(Handle handle)
+    {
+        if (!table.IsValid(handle))
+        {
+            return;
+        }
+
+        Base *obj = dense[table.DenseIndex(handle)];
+        uint32_t vacated = table.Free(handle);
+        dense[vacated] = dense.back();
+        dense.pop_back();
+
+        // Memory stays with the slot for reuse
+        obj->~Base();
+    }
+
+    /** @brief Destroy an object owned by this pool */
+    inline void Destroy(Base *obj)
+    {
+        if (obj != nullptr)
+        {
+            Destroy(obj->handle);
+        }
+    }
+
+    /** @brief Destroy every live object, keeping slot memory for reuse */
+    inline void Clear()
+    {
+        while (!dense.empty())
+        {
+            Destroy(dense.back()->handle);
+        }
+    }
+
+    /** @brief Resolve a handle, or `nullptr` if it is stale */
+    inline Base *Get(Handle handle) const
+    {
+        return table.IsValid(handle) ? dense[table.DenseIndex(handle)] : nullptr;
+    }
+
+    /** @brief Resolve a handle to a derived type, or `nullptr` if it is stale */
+    template <typename T>
+        requires std::is_base_of_v<Base, T>
+    inline T *Get(Handle handle) const
+    {
+        return static_cast<T *>(Get(handle));
+    }
+
+    inline bool IsValid(Handle handle) const
+    {
+        return table.IsValid(handle);
+    }
+
+    /** @brief Number of live objects */
+    inline size_t Size() const
+    {
+        return dense.size();
+    }
+
+    /** Dense accessors for iteration over live objects */
+    inline Base *operator[](size_t index) const
+    {
+        return dense[index];
+    }
+
+    inline Base *const *begin() const
+    {
+        return dense.data();
+    }
+
+    inline Base *const *end() const
+    {
+        return dense.data() + dense.size();
+    }
+
+private:
+    struct Block
+    {
+        void *memory = nullptr;
+        size_t capacity = 0;
+    };
+
+    HandleTable table;
+    std::vector<Block> blocks;
+    std::vector<Base *> dense;
+};
@@ -40,8 +40,6 @@ public:
 
     GLGame(GLGraphics *glGraphics) : Game(), gl{glGraphics}
     {
-        std::fill_n(gameObjects, MAX_GAME_OBJECTS, nullptr);
-
         if (!gl->Initialize(XBounds::width(), YBounds::height(), "Test Window"))
         {
             throw std::runtime_error("Could not create window");
@@ -59,14 +57,11 @@ public:
         gl->ClearScreen(1, 1, 1);
 
         // Draw objects
-        for (uint i = 0; i < MAX_GAME_OBJECTS; i++)
+        for (Entity *obj : gameObjects)
         {
-            if (gameObjects[i] != nullptr)
+            if (obj->IsEnabled())
             {
-                if (gameObjects[i]->IsEnabled())
-                {
-                    gameObjects[i]->Draw();
-                }
+                obj->Draw();
             }
         }
 
@@ -87,23 +82,17 @@ template <IsGame G>
     requires std::is_base_of_v<GLGame, G>
 int PlayGame()
 {
-    XBounds::SetLowerBound(0);
-    XBounds::SetUpperBound(0 + G::GET_DEFAULT_WIDTH());
-    YBounds::SetLowerBound(0);
-    YBounds::SetUpperBound(0 + G::GET_DEFAULT_HEIGHT());
+    DefaultBounds<G>().Install();
 
     GLGraphics gl{};
     G *game = new G(&gl);
+    WorldScope scope{*game};
 
     game->Initialize();
     while (!gl.ShouldClose())
     {
         gl.ProcessInput();
-
-        game->Update();
-        game->Draw();
-
-        usleep(1000 * 16);
+        game->Tick();
     }
     return 0;
 }
\ No newline at end of file
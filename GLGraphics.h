@@ -1,18 +1,37 @@
 #pragma once
 
 #define GL_SILENCE_DEPRECATION
+// Triangles per draw call; DrawTriangle flushes early if a frame has more
 #define MAX_TRIANGLES 200
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 #include "Keypress.h"
 #include "Triangle.h"
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <iostream>
 
+/** @brief Segments of the streaming vertex ring: one being filled while the GPU may still read the other two */
+constexpr size_t GL_RING_SEGMENTS = 3;
+constexpr size_t GL_SEGMENT_VERTICES = MAX_TRIANGLES * 3;
+/** @brief How long to block on a segment's fence before checking again, in nanoseconds */
+constexpr uint64_t GL_FENCE_WAIT_NS = 1000000;
+
+static_assert(sizeof(Vector3<float>) == 3 * sizeof(float), "Vertices are uploaded as tightly packed floats");
+
+/** @brief Where a GLGraphics sends its output */
+enum GLBackend
+{
+    kGLBackendWindow,
+    // No window or GL context: every call succeeds, draws are discarded
+    kGLBackendNull,
+};
+
 class GLGraphics {
 public:
-    GLGraphics() : window(nullptr), width(800), height(600), title("GLGraphics") {}
+    GLGraphics(GLBackend backend_ = kGLBackendWindow) : window(nullptr), width(800), height(600), title("GLGraphics"), backend(backend_) {}
     ~GLGraphics() { Terminate(); }
 
     static void framebuffer_size_callback(GLFWwindow*, int width, int height){ glViewport(0, 0, width, height); }
@@ -20,6 +39,10 @@ public:
     // Initialize headless window (for tracking keypresses)
     bool InitializeHeadless()
     {
+        if (IsNull())
+        {
+            return true;
+        }
         if (!glfwInit())
         {
             std::cout << "Failed to initialize GLFW" << std::endl;
@@ -41,6 +64,10 @@ public:
 
     void UpdateHeadless()
     {
+        if (IsNull())
+        {
+            return;
+        }
         glfwPollEvents();
     }
 
@@ -50,6 +77,11 @@ public:
         height = h;
         title = windowTitle;
 
+        if (IsNull())
+        {
+            return true;
+        }
+
         if (!glfwInit())
         {
             std::cout << "Failed to initialize GLFW" << std::endl;
@@ -88,6 +120,11 @@ public:
     }
 
     bool BuildShaders(){
+        if (IsNull())
+        {
+            return true;
+        }
+
         unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
         glCompileShader(vertexShader);
@@ -128,16 +165,25 @@ public:
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
 
+        CreateBuffers_();
         return 1;
     }
 
     // Clears or Processes the screen with a given color
     void ClearScreen(float r, float g, float b, float a = 1.0f) {   
+        if (IsNull())
+        {
+            return;
+        }
         glClearColor(r, g, b, a);
         glClear(GL_COLOR_BUFFER_BIT);
     }
 
     void ProcessInput() {
+        if (IsNull())
+        {
+            return;
+        }
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS){
             glfwSetWindowShouldClose(window, true);
         }    
@@ -145,7 +191,11 @@ public:
 
     // Draw a triangle with given vertices
     void DrawTriangle(Triangle<float> &triangle) {
-    
+        if (verticeCount + 3 > GL_SEGMENT_VERTICES)
+        {
+            FlushBuffer();
+        }
+
         triangleVerticeBuffer[verticeCount++] = triangle._p1;
         triangleVerticeBuffer[verticeCount++] = triangle._p2;
         triangleVerticeBuffer[verticeCount++] = triangle._p3;
@@ -168,28 +218,49 @@ public:
 
     }
 
+    /**
+     * @brief Draw the queued triangles. They are copied into the next segment
+     * of the vertex ring, once the GPU has finished with that segment's last
+     * use, and drawn with a single call.
+     */
     void FlushBuffer(){
         if(triangleCount < 1){
             return;
         }
+        if (IsNull())
+        {
+            triangleCount = 0;
+            verticeCount = 0;
+            return;
+        }
 
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
+        WaitForSegment_(segment);
 
-        glBindVertexArray(VAO);
+        const GLintptr offset = segment * GL_SEGMENT_VERTICES * sizeof(Vector3<float>);
+        const GLsizeiptr bytes = verticeCount * sizeof(Vector3<float>);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-        glBufferData(GL_ARRAY_BUFFER, triangleCount * sizeof(Triangle<float>), triangleVerticeBuffer, GL_DYNAMIC_DRAW);
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-        glEnableVertexAttribArray(0);
+        // The fence says the GPU is done with this range, so no driver-side synchronization is needed
+        void *dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst != nullptr)
+        {
+            std::memcpy(dst, triangleVerticeBuffer, bytes);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        else
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, triangleVerticeBuffer);
+        }
         glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind VBO
 
         glUseProgram(shaderProgram);
         glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, triangleCount * 3);
+        glDrawArrays(GL_TRIANGLES, segment * GL_SEGMENT_VERTICES, verticeCount);
         glBindVertexArray(0); //unbind VAO
 
+        fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        segment = (segment + 1) % GL_RING_SEGMENTS;
+
         triangleCount = 0;
         verticeCount = 0;
     }
@@ -197,30 +268,98 @@ public:
     // Swaps buffers and polls events
     void EndFrame() {
         FlushBuffer();
+        if (IsNull())
+        {
+            return;
+        }
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
     bool ShouldClose() {
+        if (IsNull())
+        {
+            return false;
+        }
         return glfwWindowShouldClose(window);
     }
 
     void Terminate() {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
+        if (IsNull())
+        {
+            return;
+        }
+        for (GLsync &fence : fences)
+        {
+            if (fence != nullptr)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        if (VAO != 0)
+        {
+            glDeleteVertexArrays(1, &VAO);
+            glDeleteBuffers(1, &VBO);
+            VAO = VBO = 0;
+        }
         glDeleteProgram(shaderProgram);
         glfwTerminate();
     }
+    /** @brief True if this instance discards all output (see kGLBackendNull) */
+    bool IsNull() const {
+        return backend == kGLBackendNull;
+    }
 
+private:
+    /** @brief Create the VAO and the vertex ring once; the attribute layout is recorded in the VAO for good */
+    void CreateBuffers_()
+    {
+        if (VAO != 0)
+        {
+            return;
+        }
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, GL_RING_SEGMENTS * GL_SEGMENT_VERTICES * sizeof(Vector3<float>), nullptr, GL_STREAM_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 
+    /** @brief Block until the GPU has finished the draw that last read ring segment `index` */
+    void WaitForSegment_(size_t index)
+    {
+        GLsync &fence = fences[index];
+        if (fence == nullptr)
+        {
+            return;
+        }
+        GLenum status;
+        do
+        {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_FENCE_WAIT_NS);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
 
-private:
     GLFWwindow *window;
-    int width, height, triangleCount = 0, verticeCount = 0;
+    int width, height, triangleCount = 0;
+    size_t verticeCount = 0;
     std::string title;
-    GLuint VAO, VBO;
+    GLBackend backend;
+    GLuint VAO = 0, VBO = 0;
     unsigned int shaderProgram;
-    Vector3<float> triangleVerticeBuffer[MAX_TRIANGLES];
+    // Vertex ring: segment to fill next, and the fence of the last draw from each segment
+    size_t segment = 0;
+    GLsync fences[GL_RING_SEGMENTS] = {};
+    // CPU staging for the current batch; three vertices per triangle
+    Vector3<float> triangleVerticeBuffer[GL_SEGMENT_VERTICES];
     //Shader programs
     const char *vertexShaderSource = "#version 330 core\n"
         "layout (location = 0) in vec3 aPos;\n"
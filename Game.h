@@ -1,11 +1,17 @@
 #pragma once
 
 #include "GameTypes.h"
+#include "EntityPool.h"
+#include "GameLoop.h"
 #include "UnitLib/Unit.h"
 #include "UnitLib/Vector.h"
 #include "UnitLib/Matrix.h"
+#include "UnitLib/BatchMath.h"
 #include "Keypress.h"
-#include <unistd.h>
+#include "Rng.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Consts
@@ -15,19 +21,57 @@ constexpr size_t MAX_GAME_OBJECTS = 1024;
 constexpr size_t MAX_CHILDREN = 16;
 constexpr double DEFAULT_WIDTH = 320;
 constexpr double DEFAULT_HEIGHT = 240;
+constexpr uint64_t DEFAULT_WORLD_SEED = 1;
 
 constexpr char OBJECTSPACE[] = "objectspace";
 constexpr char WORLDSPACE[] = "worldspace";
 constexpr char FRAME[] = "frame";
 
+//------------------------------------------------------------------------------
+// Per-world state
+//
+//   Every Game is an independent world with its own bounds, key state and
+//   random engine. Code below the Game (clipped coordinates, objects calling
+//   fRand or KeyEventManager::GetInstance()) reaches them through thread-local
+//   bindings, which a WorldScope points at one world for as long as it is
+//   being stepped. Worlds on different threads therefore never share state.
+//------------------------------------------------------------------------------
+
+/** @brief Random engine of the world bound to the calling thread */
+struct WorldRandom
+{
+    using Engine = Rng;
+
+    inline static Engine &Get()
+    {
+        return current != nullptr ? *current : Default_();
+    }
+
+    /** @brief Bind `engine` to the calling thread (nullptr for the default). Returns the previous binding */
+    inline static Engine *Bind(Engine *engine)
+    {
+        Engine *previous = current;
+        current = engine;
+        return previous;
+    }
+
+private:
+    inline static Engine &Default_()
+    {
+        thread_local Engine engine{DEFAULT_WORLD_SEED};
+        return engine;
+    }
+
+    inline static thread_local Engine *current = nullptr;
+};
+
 /**
- * Helper function
+ * Helper function: uniform in [fMin, fMax), from the bound world's engine
  */
 
 double fRand(double fMin, double fMax)
 {
-    double f = (double)rand() / RAND_MAX;
-    return fMin + f * (fMax - fMin);
+    return WorldRandom::Get().Uniform(fMin, fMax);
 }
 
 
@@ -35,12 +79,13 @@ double fRand(double fMin, double fMax)
 // Bounded type definnitions
 //------------------------------------------------------------------------------
 
+// Bounds are per thread: they hold the bounds of the world bound to that thread
 struct XBounds
 {
     static void SetLowerBound(double lb) { lowerBound = lb; };
     static void SetUpperBound(double ub) { upperBound = ub; };
-    inline static double upperBound;
-    inline static double lowerBound;
+    inline static thread_local double upperBound;
+    inline static thread_local double lowerBound;
     static double width() { return upperBound - lowerBound; };
 };
 
@@ -48,10 +93,33 @@ struct YBounds
 {
     static void SetLowerBound(double lb) { lowerBound = lb; };
     static void SetUpperBound(double ub) { upperBound = ub; };
-    inline static double upperBound;
-    inline static double lowerBound;
+    inline static thread_local double upperBound;
+    inline static thread_local double lowerBound;
     static double height() { return upperBound - lowerBound; };
 };
+
+/** @brief Extents of one world, installed into XBounds/YBounds while it is bound */
+struct WorldBounds
+{
+    double xLower = 0;
+    double xUpper = DEFAULT_WIDTH;
+    double yLower = 0;
+    double yUpper = DEFAULT_HEIGHT;
+
+    /** @brief Bounds currently installed on the calling thread */
+    inline static WorldBounds Current()
+    {
+        return {XBounds::lowerBound, XBounds::upperBound, YBounds::lowerBound, YBounds::upperBound};
+    }
+
+    inline void Install() const
+    {
+        XBounds::SetLowerBound(xLower);
+        XBounds::SetUpperBound(xUpper);
+        YBounds::SetLowerBound(yLower);
+        YBounds::SetUpperBound(yUpper);
+    }
+};
 using ClippedX = ClipDouble<XBounds>;
 using ClippedY = ClipDouble<YBounds>;
 
@@ -184,17 +252,93 @@ public:
     inline virtual bool Collide(const Vector2<Worldspace> &) { return false; };
     inline virtual void Update() = 0;
     inline virtual void Draw() = 0;
+    /** @brief Called once, when the entity is first disabled */
+    inline virtual void OnDisable() {};
     inline void Disable()
     {
-        enabled = false;
+        if (enabled)
+        {
+            enabled = false;
+            OnDisable();
+        }
     }
     inline bool IsEnabled()
     {
         return enabled;
     }
+    /** @brief Handle of this entity in its owning pool (null if not pool-owned) */
+    inline Handle GetHandle() const
+    {
+        return handle;
+    }
 
 private:
     bool enabled = true;
+    Handle handle{};
+    Entity *nextSibling = nullptr;
+
+    template <typename, size_t>
+    friend class EntityPool;
+    friend class ChildList;
+};
+
+/**
+ * @brief Owning list of child entities. The links are intrusive (stored in the
+ * children themselves), so a parent pays for two pointers and a count no matter
+ * how many children it could hold, and children are visited in insertion order.
+ */
+class ChildList
+{
+public:
+    ChildList() {};
+    ~ChildList()
+    {
+        Entity *child = head;
+        while (child != nullptr)
+        {
+            Entity *next = child->nextSibling;
+            delete child;
+            child = next;
+        }
+    }
+
+    ChildList(const ChildList &) = delete;
+    ChildList &operator=(const ChildList &) = delete;
+
+    /** @brief Append a heap-allocated child; the list takes ownership */
+    inline void PushBack(Entity *child)
+    {
+        if (tail != nullptr)
+        {
+            tail->nextSibling = child;
+        }
+        else
+        {
+            head = child;
+        }
+        tail = child;
+        count++;
+    }
+
+    /** @brief Call `fn(Entity *)` on each child in insertion order */
+    template <typename Fn>
+    inline void ForEach(Fn &&fn) const
+    {
+        for (Entity *child = head; child != nullptr; child = child->nextSibling)
+        {
+            fn(child);
+        }
+    }
+
+    inline size_t Size() const
+    {
+        return count;
+    }
+
+private:
+    Entity *head = nullptr;
+    Entity *tail = nullptr;
+    uint32_t count = 0;
 };
 
 template <size_t Depth>
@@ -211,26 +355,10 @@ public:
     template <template <size_t> class ChildObj>
     using Child = ChildObj<Depth + 1>;
 
-    ~GameObject()
-    {
-        for (uint i = 0; i < MAX_CHILDREN; i++)
-        {
-            if (children[i] != nullptr)
-            {
-                delete children[i];
-            }
-        }
-    };
-
     inline virtual void Update()
     {
-        for (uint i = 0; i < MAX_CHILDREN; i++)
-        {
-            if (children[i] != nullptr)
-            {
-                children[i]->Update();
-            }
-        }
+        children.ForEach([](Entity *child)
+                         { child->Update(); });
     }
 
     template <template <size_t> class ChildObj, typename... Args>
@@ -238,19 +366,16 @@ public:
                  std::is_constructible_v<Child<ChildObj>, Args...>
     Child<ChildObj> *AddChild(Args... argList)
     {
-        for (uint i = 0; i < MAX_CHILDREN; i++)
+        if (children.Size() >= MAX_CHILDREN)
         {
-            if (children[i] == nullptr)
-            {
-                Child<ChildObj> *obj = new Child<ChildObj>(argList...);
-                obj->parent = this;
-                children[i] = obj;
-                children[i]->Initialize();
-                return obj;
-            }
+            throw std::runtime_error("Too many children!");
         }
 
-        throw std::runtime_error("Too many children!");
+        Child<ChildObj> *obj = new Child<ChildObj>(argList...);
+        obj->parent = this;
+        children.PushBack(obj);
+        obj->Initialize();
+        return obj;
     };
 
     inline Vector2<ObjCoord<Depth>> ApplyTransform(const Vector2<ObjCoord<Depth + 1>> &vec)
@@ -285,7 +410,7 @@ protected:
     Vector2<VelType<Coord>> vel{};
     Vector2<AccType<Coord>> acc{};
     GameObject<Depth - 1> *parent = nullptr;
-    Entity *children[MAX_GAME_OBJECTS] = {nullptr};
+    ChildList children;
 
     friend class GameObject<Depth - 1>;
 };
@@ -306,65 +431,278 @@ template <typename T>
 concept IsEntity = std::is_base_of_v<Entity, T>;
 
 //------------------------------------------------------------------------------
-// Game class
+// Kinematic components
 //------------------------------------------------------------------------------
 
-class Game
+/**
+ * @brief Structure-of-arrays storage for world-space position/velocity/acceleration.
+ * Bodies that opt in keep their kinematic state here instead of inside their
+ * GameObject, so a single `Integrate` pass can advance all of them without any
+ * virtual dispatch, walking each component as one contiguous array.
+ *
+ * Entries are addressed by generational handles; removal swap-removes, so the
+ * arrays stay dense. Accessors assume the handle is valid.
+ */
+template <WrapType Wrap = kWrapNone>
+class KinematicStore
 {
 public:
-    inline static double GET_DEFAULT_WIDTH() { return DEFAULT_WIDTH; };
-    inline static double GET_DEFAULT_HEIGHT() { return DEFAULT_HEIGHT; };
+    using PosX = WorldX<Wrap>;
+    using PosY = WorldY<Wrap>;
+
+    KinematicStore() {};
+
+    KinematicStore(const KinematicStore &) = delete;
+    KinematicStore &operator=(const KinematicStore &) = delete;
 
-    Game()
+    inline void Reserve(size_t n)
     {
-        std::fill_n(gameObjects, MAX_GAME_OBJECTS, nullptr);
-    };
-    ~Game()
+        table.Reserve(n);
+        x.reserve(n);
+        y.reserve(n);
+        vx.reserve(n);
+        vy.reserve(n);
+        ax.reserve(n);
+        ay.reserve(n);
+    }
+
+    inline Handle Add(const Vector2<Worldspace> &pos = Vector2<Worldspace>{},
+                      const Vector2<World_per_Frame> &vel = Vector2<World_per_Frame>{},
+                      const Vector2<World_per_Frame_2> &acc = Vector2<World_per_Frame_2>{})
     {
-        for (uint i = 0; i < MAX_GAME_OBJECTS; i++)
+        Handle handle = table.Allocate();
+        x.push_back(pos.x());
+        y.push_back(pos.y());
+        vx.push_back(vel.x());
+        vy.push_back(vel.y());
+        ax.push_back(acc.x());
+        ay.push_back(acc.y());
+        return handle;
+    }
+
+    /** @brief Remove an entry. Stale handles are ignored */
+    inline void Remove(Handle handle)
+    {
+        if (!table.IsValid(handle))
         {
-            if (gameObjects[i] != nullptr)
-            {
-                delete gameObjects[i];
-            }
+            return;
         }
-    };
 
-    template <typename GameObj, typename... Args>
-        requires IsEntity<GameObj> &&
-                 std::is_constructible_v<GameObj, Args...>
-    inline GameObj *CreateGameObject(Args... argList)
+        uint32_t i = table.Free(handle);
+        SwapRemove(x, i);
+        SwapRemove(y, i);
+        SwapRemove(vx, i);
+        SwapRemove(vy, i);
+        SwapRemove(ax, i);
+        SwapRemove(ay, i);
+    }
+
+    inline bool IsValid(Handle handle) const
+    {
+        return table.IsValid(handle);
+    }
+
+    inline size_t Size() const
     {
-        for (uint i = 0; i < MAX_GAME_OBJECTS; i++)
+        return x.size();
+    }
+
+    /** @brief Advance every body by `dt`: semi-implicit Euler, matching GameObject updates */
+    inline void Integrate(Frame dt)
+    {
+        if constexpr (BatchElement<PosX> && BatchElement<PosY>)
         {
-            if (gameObjects[i] == nullptr)
+            BatchIntegrate(x, vx, ax, dt);
+            BatchIntegrate(y, vy, ay, dt);
+        }
+        else
+        {
+            // Clipped coordinates wrap on every write, so only velocities go through the batch kernel
+            BatchAddScaled(vx, ax, dt);
+            BatchAddScaled(vy, ay, dt);
+
+            const size_t n = Size();
+            for (size_t i = 0; i < n; i++)
             {
-                GameObj *obj = new GameObj(argList...);
-                obj->Initialize();
-                gameObjects[i] = obj;
-                return obj;
+                x[i] += vx[i] * dt;
+                y[i] += vy[i] * dt;
             }
         }
+    }
+
+    /**
+     * Per-entry accessors
+     */
+    inline PosX GetX(Handle handle) const { return x[table.DenseIndex(handle)]; }
+    inline PosY GetY(Handle handle) const { return y[table.DenseIndex(handle)]; }
+
+    inline Vector2<Worldspace> GetPos(Handle handle) const
+    {
+        uint32_t i = table.DenseIndex(handle);
+        return {x[i], y[i]};
+    }
+    inline Vector2<World_per_Frame> GetVel(Handle handle) const
+    {
+        uint32_t i = table.DenseIndex(handle);
+        return {vx[i], vy[i]};
+    }
+    inline Vector2<World_per_Frame_2> GetAcc(Handle handle) const
+    {
+        uint32_t i = table.DenseIndex(handle);
+        return {ax[i], ay[i]};
+    }
+
+    inline void SetPos(Handle handle, const Vector2<Worldspace> &pos)
+    {
+        uint32_t i = table.DenseIndex(handle);
+        x[i] = pos.x();
+        y[i] = pos.y();
+    }
+    inline void SetVel(Handle handle, const Vector2<World_per_Frame> &vel)
+    {
+        uint32_t i = table.DenseIndex(handle);
+        vx[i] = vel.x();
+        vy[i] = vel.y();
+    }
+    inline void SetAcc(Handle handle, const Vector2<World_per_Frame_2> &acc)
+    {
+        uint32_t i = table.DenseIndex(handle);
+        ax[i] = acc.x();
+        ay[i] = acc.y();
+    }
+
+private:
+    template <typename T>
+    inline static void SwapRemove(std::vector<T> &vec, uint32_t i)
+    {
+        vec[i] = vec.back();
+        vec.pop_back();
+    }
+
+    HandleTable table;
+    std::vector<PosX> x;
+    std::vector<PosY> y;
+    std::vector<World_per_Frame> vx;
+    std::vector<World_per_Frame> vy;
+    std::vector<World_per_Frame_2> ax;
+    std::vector<World_per_Frame_2> ay;
+};
+
+/**
+ * @brief Owning reference to one entry of a KinematicStore. A GameObject holds
+ * one of these in place of its own pos/vel/acc to opt into batched integration;
+ * the entry is released when the body is destroyed, or earlier by Release().
+ * Accessors assume the body has not been released.
+ */
+template <WrapType Wrap = kWrapNone>
+class KinematicBody
+{
+public:
+    KinematicBody(KinematicStore<Wrap> &store_, const Vector2<Worldspace> &pos = Vector2<Worldspace>{})
+        : store{&store_}, handle{store_.Add(pos)} {};
+    ~KinematicBody()
+    {
+        store->Remove(handle);
+    }
+
+    KinematicBody(const KinematicBody &) = delete;
+    KinematicBody &operator=(const KinematicBody &) = delete;
+
+    /** @brief Remove the entry from the store, so it is no longer integrated */
+    inline void Release()
+    {
+        store->Remove(handle);
+        handle = Handle{};
+    }
+
+    inline bool IsReleased() const
+    {
+        return !store->IsValid(handle);
+    }
+
+    inline WorldX<Wrap> X() const { return store->GetX(handle); }
+    inline WorldY<Wrap> Y() const { return store->GetY(handle); }
+
+    inline Vector2<Worldspace> GetPos() const { return store->GetPos(handle); }
+    inline Vector2<World_per_Frame> GetVel() const { return store->GetVel(handle); }
+    inline Vector2<World_per_Frame_2> GetAcc() const { return store->GetAcc(handle); }
+
+    inline void SetPos(const Vector2<Worldspace> &pos) { store->SetPos(handle, pos); }
+    inline void SetVel(const Vector2<World_per_Frame> &vel) { store->SetVel(handle, vel); }
+    inline void SetAcc(const Vector2<World_per_Frame_2> &acc) { store->SetAcc(handle, acc); }
+
+private:
+    KinematicStore<Wrap> *store;
+    Handle handle;
+};
+
+//------------------------------------------------------------------------------
+// Game class
+//------------------------------------------------------------------------------
+
+class Game
+{
+public:
+    inline static double GET_DEFAULT_WIDTH() { return DEFAULT_WIDTH; };
+    inline static double GET_DEFAULT_HEIGHT() { return DEFAULT_HEIGHT; };
+    inline static double GET_DEFAULT_ORIGIN() { return 0; };
+
+    /** @brief A new world takes the bounds currently installed on the calling thread */
+    Game() : bounds{WorldBounds::Current()} {};
+    virtual ~Game() {};
 
-        throw std::runtime_error("Too many game objects!");
-        return nullptr;
+    template <typename GameObj, typename... Args>
+        requires IsEntity<GameObj> &&
+                 std::is_constructible_v<GameObj, Args...>
+    inline GameObj *CreateGameObject(Args &&...argList)
+    {
+        GameObj *obj = gameObjects.template Create<GameObj>(std::forward<Args>(argList)...);
+        obj->Initialize();
+        return obj;
     };
 
+    /** @brief Destroy a game object. Must not be called while objects are being updated/drawn */
+    inline void DestroyGameObject(Entity *obj)
+    {
+        gameObjects.Destroy(obj);
+    }
+
+    inline void DestroyGameObject(Handle handle)
+    {
+        gameObjects.Destroy(handle);
+    }
+
+    /** @brief Resolve a handle to a game object, or `nullptr` if it has been destroyed */
+    template <typename GameObj>
+        requires IsEntity<GameObj>
+    inline GameObj *GetGameObject(Handle handle)
+    {
+        return gameObjects.template Get<GameObj>(handle);
+    }
+
+    /** @brief Kinematic store for bodies with the given wrap mode, integrated once per update */
+    template <WrapType Wrap>
+    inline KinematicStore<Wrap> &GetKinematics()
+    {
+        return std::get<Wrap>(kinematics);
+    }
+
     inline virtual void Initialize() = 0;
 
     inline virtual void Update()
     {
-        KeyEventManager::GetInstance().Update(frameCount);
+        keys.Update(frameCount);
         frameCount++;
 
-        for (uint i = 0; i < MAX_GAME_OBJECTS; i++)
+        std::apply([](auto &...store)
+                   { (store.Integrate(1_frame), ...); }, kinematics);
+
+        // Index loop: objects created during the update are appended and also updated
+        for (size_t i = 0; i < gameObjects.Size(); i++)
         {
-            if (gameObjects[i] != nullptr)
+            if (gameObjects[i]->IsEnabled())
             {
-                if (gameObjects[i]->IsEnabled())
-                {
-                    gameObjects[i]->Update();
-                }
+                gameObjects[i]->Update();
             }
         }
 
@@ -375,14 +713,140 @@ public:
 
     inline virtual void Draw() = 0;
 
+    /**
+     * @brief Run one frame of the game loop: every fixed Update that is due,
+     * then Draw. Paces itself, so callers just call it repeatedly.
+     */
+    inline void Tick()
+    {
+        loop.Tick([this]()
+                  { Update(); },
+                  [this](double alpha)
+                  {
+                      renderAlpha = alpha;
+                      Draw(); });
+    }
+
+    /**
+     * @brief Fraction of an update period that has elapsed since the last
+     * Update, in [0, 1). Draw can use it to interpolate between states.
+     */
+    inline double GetRenderAlpha() const
+    {
+        return renderAlpha;
+    }
+
+    inline const FrameStats &GetFrameStats() const
+    {
+        return loop.GetStats();
+    }
+
+    inline GameLoop &GetLoop()
+    {
+        return loop;
+    }
+
+    /**
+     * Per-world state, bound to a thread by WorldScope
+     */
+    inline const WorldBounds &GetBounds() const
+    {
+        return bounds;
+    }
+
+    inline KeyEventManager &GetKeys()
+    {
+        return keys;
+    }
+
+    /**
+     * @brief Reseed this world's random engine. Seeding before Initialize makes
+     * a run reproducible: the same seed and inputs replay the same simulation
+     * bit-for-bit.
+     */
+    inline void Seed(uint64_t seed)
+    {
+        rng.Seed(seed);
+    }
+
+    inline Rng &GetRng()
+    {
+        return rng;
+    }
+
 protected:
     uint frameCount = 0;
-    Entity *gameObjects[MAX_GAME_OBJECTS] = {nullptr};
+    WorldBounds bounds;
+    KeyEventManager keys;
+    WorldRandom::Engine rng{DEFAULT_WORLD_SEED};
+    double renderAlpha = 0;
+    GameLoop loop;
+    // Declared before gameObjects so that objects holding KinematicBody entries are destroyed first
+    std::tuple<KinematicStore<kWrapNone>, KinematicStore<kWrapX>,
+               KinematicStore<kWrapY>, KinematicStore<kWrapBoth>>
+        kinematics;
+    EntityPool<Entity, MAX_GAME_OBJECTS> gameObjects;
+
+    friend class WorldScope;
 };
 
 template <typename T>
 concept IsGame = std::is_base_of_v<Game, T>;
 
+/** @brief Bounds a game of type `G` is played in */
+template <IsGame G>
+WorldBounds DefaultBounds()
+{
+    double origin = G::GET_DEFAULT_ORIGIN();
+    return {origin, origin + G::GET_DEFAULT_WIDTH(), origin, origin + G::GET_DEFAULT_HEIGHT()};
+}
+
+//------------------------------------------------------------------------------
+// World binding
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Binds a world to the calling thread for the lifetime of the scope:
+ * installs its bounds and points KeyEventManager::GetInstance() and fRand at
+ * its key state and engine. The previous binding is restored on exit, so
+ * scopes nest.
+ */
+class WorldScope
+{
+public:
+    explicit WorldScope(Game &game)
+        : previousBounds{WorldBounds::Current()},
+          previousKeys{KeyEventManager::Bind(&game.keys)},
+          previousRng{WorldRandom::Bind(&game.rng)}
+    {
+        game.bounds.Install();
+    }
+
+    /** @brief Install bounds only, e.g. while constructing a world that will take them */
+    explicit WorldScope(const WorldBounds &bounds)
+        : previousBounds{WorldBounds::Current()},
+          previousKeys{KeyEventManager::Bind(&KeyEventManager::GetInstance())},
+          previousRng{WorldRandom::Bind(&WorldRandom::Get())}
+    {
+        bounds.Install();
+    }
+
+    ~WorldScope()
+    {
+        previousBounds.Install();
+        KeyEventManager::Bind(previousKeys);
+        WorldRandom::Bind(previousRng);
+    }
+
+    WorldScope(const WorldScope &) = delete;
+    WorldScope &operator=(const WorldScope &) = delete;
+
+private:
+    WorldBounds previousBounds;
+    KeyEventManager *previousKeys;
+    WorldRandom::Engine *previousRng;
+};
+
 /**
  * Game loop
  */
@@ -390,19 +854,14 @@ concept IsGame = std::is_base_of_v<Game, T>;
 template <IsGame G>
 int PlayGame()
 {
+    DefaultBounds<G>().Install();
     G *game = new G();
-    XBounds::SetLowerBound(0);
-    XBounds::SetUpperBound(0 + G::GET_DEFAULT_WIDTH());
-    YBounds::SetLowerBound(0);
-    YBounds::SetUpperBound(0 + G::GET_DEFAULT_HEIGHT());
+    WorldScope scope{*game};
 
     game->Initialize();
     while (1)
     {
-        game->Update();
-        game->Draw();
-
-        usleep(1000 * 16);
+        game->Tick();
     }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sys/types.h>
+#include <thread>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+/** @brief Default fixed simulation step (60 updates per second) */
+constexpr std::chrono::nanoseconds DEFAULT_UPDATE_PERIOD{1'000'000'000 / 60};
+/** @brief Default render pacing (60 frames per second) */
+constexpr std::chrono::nanoseconds DEFAULT_RENDER_PERIOD{1'000'000'000 / 60};
+/** @brief Default cap on updates run in a single frame while catching up */
+constexpr uint DEFAULT_MAX_UPDATES_PER_FRAME = 5;
+
+//------------------------------------------------------------------------------
+// Frame statistics
+//------------------------------------------------------------------------------
+
+/** @brief Weight of the newest sample in the moving averages of FrameStats */
+constexpr double FRAME_STATS_SMOOTHING = 0.1;
+
+/**
+ * @brief Timing statistics collected by GameLoop. Durations are in milliseconds;
+ * `avg*` fields are exponential moving averages.
+ */
+struct FrameStats
+{
+    uint64_t frames = 0;
+    uint64_t updates = 0;
+    /** @brief Updates skipped because the loop fell further behind than the catch-up cap */
+    uint64_t droppedUpdates = 0;
+
+    /** @brief Updates run during the most recent frame */
+    uint lastFrameUpdates = 0;
+    /** @brief Interpolation alpha passed to the most recent draw */
+    double lastAlpha = 0;
+
+    /** @brief Time between the starts of the last two frames */
+    double lastFrameMs = 0;
+    double avgFrameMs = 0;
+    double maxFrameMs = 0;
+    /** @brief Time spent in a single update */
+    double avgUpdateMs = 0;
+    /** @brief Time spent drawing a frame */
+    double avgDrawMs = 0;
+
+    inline double AverageFps() const
+    {
+        return avgFrameMs > 0 ? 1000.0 / avgFrameMs : 0;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Time sources
+//------------------------------------------------------------------------------
+
+/** @brief Real time: the steady clock, with sleeps blocking the calling thread */
+struct SteadyTimeSource
+{
+    using Clock = std::chrono::steady_clock;
+
+    inline static Clock::time_point Now()
+    {
+        return Clock::now();
+    }
+
+    inline static void SleepUntil(Clock::time_point time)
+    {
+        std::this_thread::sleep_until(time);
+    }
+};
+
+//------------------------------------------------------------------------------
+// GameLoop definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-timestep game loop with decoupled rendering.
+ * - Real time accumulates every frame and is consumed in fixed `updatePeriod`
+ *   steps, so the simulation rate does not depend on how long frames take
+ * - When the loop falls behind, up to `maxUpdatesPerFrame` updates run in one
+ *   frame to catch up; anything beyond that is dropped rather than letting the
+ *   backlog grow without bound
+ * - Draw receives `alpha` in [0, 1): how far real time has progressed past the
+ *   last update, towards the next one, for interpolating between states
+ * - Frames are paced by sleeping until an absolute time, so the period does
+ *   not drift by the time spent updating and drawing
+ *
+ * Time is read and slept through `TimeSource`, which provides a `Clock` type
+ * and static `Now()` and `SleepUntil()`; tests substitute a fake one.
+ */
+template <typename TimeSource = SteadyTimeSource>
+class BasicGameLoop
+{
+public:
+    using Clock = typename TimeSource::Clock;
+
+    explicit BasicGameLoop(typename Clock::duration updatePeriod_ = DEFAULT_UPDATE_PERIOD,
+                           typename Clock::duration renderPeriod_ = DEFAULT_RENDER_PERIOD,
+                           uint maxUpdatesPerFrame_ = DEFAULT_MAX_UPDATES_PER_FRAME)
+        : updatePeriod{updatePeriod_}, renderPeriod{renderPeriod_}, maxUpdatesPerFrame{maxUpdatesPerFrame_}
+    {
+    }
+
+    /**
+     * @brief Run one frame: every fixed update that is due (calling `update()`),
+     * then `draw(alpha)`, then sleep until the next frame is due.
+     */
+    template <typename UpdateFn, typename DrawFn>
+    inline void Tick(UpdateFn &&update, DrawFn &&draw)
+    {
+        typename Clock::time_point frameStart = TimeSource::Now();
+        if (!started)
+        {
+            // The first frame runs exactly one update
+            started = true;
+            lastFrameStart = frameStart;
+            nextFrame = frameStart;
+            accumulator = updatePeriod;
+        }
+
+        typename Clock::duration frameTime = frameStart - lastFrameStart;
+        lastFrameStart = frameStart;
+        accumulator += frameTime;
+
+        // Fixed updates
+        uint frameUpdates = 0;
+        while (accumulator >= updatePeriod && frameUpdates < maxUpdatesPerFrame)
+        {
+            typename Clock::time_point updateStart = TimeSource::Now();
+            update();
+            RecordAverage_(stats.avgUpdateMs, ToMs_(TimeSource::Now() - updateStart), stats.updates == 0);
+
+            accumulator -= updatePeriod;
+            frameUpdates++;
+            stats.updates++;
+        }
+        if (accumulator >= updatePeriod)
+        {
+            stats.droppedUpdates += static_cast<uint64_t>(accumulator / updatePeriod);
+            accumulator %= updatePeriod;
+        }
+
+        // Draw
+        double alpha = std::chrono::duration<double>(accumulator) / std::chrono::duration<double>(updatePeriod);
+        typename Clock::time_point drawStart = TimeSource::Now();
+        draw(alpha);
+        RecordAverage_(stats.avgDrawMs, ToMs_(TimeSource::Now() - drawStart), stats.frames == 0);
+
+        // Stats
+        if (stats.frames > 0)
+        {
+            stats.lastFrameMs = ToMs_(frameTime);
+            stats.maxFrameMs = std::max(stats.maxFrameMs, stats.lastFrameMs);
+            RecordAverage_(stats.avgFrameMs, stats.lastFrameMs, stats.frames == 1);
+        }
+        stats.frames++;
+        stats.lastFrameUpdates = frameUpdates;
+        stats.lastAlpha = alpha;
+
+        // Pace: if we're already late for the next frame, start it now instead of trying to catch up renders
+        nextFrame += renderPeriod;
+        typename Clock::time_point now = TimeSource::Now();
+        if (nextFrame < now)
+        {
+            nextFrame = now;
+        }
+        TimeSource::SleepUntil(nextFrame);
+    }
+
+    /** @brief Forget accumulated time, e.g. after the game was paused. Stats are kept */
+    inline void Reset()
+    {
+        started = false;
+    }
+
+    inline const FrameStats &GetStats() const
+    {
+        return stats;
+    }
+
+    inline typename Clock::duration GetUpdatePeriod() const
+    {
+        return updatePeriod;
+    }
+
+    inline typename Clock::duration GetRenderPeriod() const
+    {
+        return renderPeriod;
+    }
+
+private:
+    inline static double ToMs_(typename Clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    inline static void RecordAverage_(double &avg, double sample, bool first)
+    {
+        avg = first ? sample : avg + FRAME_STATS_SMOOTHING * (sample - avg);
+    }
+
+    typename Clock::duration updatePeriod;
+    typename Clock::duration renderPeriod;
+    uint maxUpdatesPerFrame;
+
+    bool started = false;
+    typename Clock::time_point lastFrameStart{};
+    typename Clock::time_point nextFrame{};
+    typename Clock::duration accumulator{0};
+
+    FrameStats stats;
+};
+
+using GameLoop = BasicGameLoop<>;
@@ -10,7 +10,22 @@ concept ClipBounds = requires {
 template <ClipBounds Bounds>
 double clip(double val)
 {
+    // Fast path: values are usually already in range, or just stepped across one edge
+    if (val >= Bounds::lowerBound && val < Bounds::upperBound)
+    {
+        return val;
+    }
+
     double width = Bounds::upperBound - Bounds::lowerBound;
+    if (val < Bounds::lowerBound && val + width >= Bounds::lowerBound && val + width < Bounds::upperBound)
+    {
+        return val + width;
+    }
+    if (val >= Bounds::upperBound && val - width >= Bounds::lowerBound && val - width < Bounds::upperBound)
+    {
+        return val - width;
+    }
+
     double offsetVal = val - Bounds::lowerBound;
 
     double rem = std::fmod(offsetVal, width);
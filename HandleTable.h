@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Handle definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Generational handle. `index` addresses a slot in a HandleTable and
+ * `generation` is bumped every time that slot is freed, so a handle that
+ * outlives the object it referred to can be detected instead of aliasing
+ * whatever reused the slot.
+ */
+struct Handle
+{
+    static constexpr uint32_t NULL_INDEX = UINT32_MAX;
+
+    uint32_t index = NULL_INDEX;
+    uint32_t generation = 0;
+
+    inline bool IsNull() const
+    {
+        return index == NULL_INDEX;
+    }
+
+    inline bool operator==(const Handle &other) const = default;
+};
+
+//------------------------------------------------------------------------------
+// HandleTable definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Sparse/dense index allocator.
+ * - Slots are recycled through a free list, so allocation and release are O(1)
+ * - Live slots are packed into a dense range [0, Size()), so owners can keep
+ *   their data in parallel dense arrays and iterate only over live entries
+ * Release swap-removes: the last dense entry is moved into the vacated dense
+ * index, and the owner is expected to mirror that move in its own arrays.
+ */
+class HandleTable
+{
+public:
+    /** @brief Reserve space for `n` slots up front */
+    inline void Reserve(size_t n)
+    {
+        slots.reserve(n);
+        denseToSlot.reserve(n);
+        freeList.reserve(n);
+    }
+
+    /** @brief Allocate a handle. Its dense index is always `Size() - 1` afterwards */
+    inline Handle Allocate()
+    {
+        uint32_t index;
+        if (!freeList.empty())
+        {
+            index = freeList.back();
+            freeList.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots.size());
+            slots.push_back({});
+        }
+
+        slots[index].dense = static_cast<uint32_t>(denseToSlot.size());
+        denseToSlot.push_back(index);
+        return {index, slots[index].generation};
+    }
+
+    /**
+     * @brief Release a handle. Returns the dense index that was vacated; the
+     * entry previously at `Size()` (before the call, minus one) now lives there.
+     */
+    inline uint32_t Free(Handle handle)
+    {
+        Slot &slot = slots[handle.index];
+        uint32_t dense = slot.dense;
+        uint32_t lastSlot = denseToSlot.back();
+
+        denseToSlot[dense] = lastSlot;
+        slots[lastSlot].dense = dense;
+        denseToSlot.pop_back();
+
+        slot.dense = Handle::NULL_INDEX;
+        slot.generation++;
+        freeList.push_back(handle.index);
+        return dense;
+    }
+
+    /** @brief Check that the handle refers to a live slot of the same generation */
+    inline bool IsValid(Handle handle) const
+    {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation &&
+               slots[handle.index].dense != Handle::NULL_INDEX;
+    }
+
+    /** @brief Dense index of a valid handle */
+    inline uint32_t DenseIndex(Handle handle) const
+    {
+        return slots[handle.index].dense;
+    }
+
+    /** @brief Handle of the entry stored at dense index `dense` */
+    inline Handle HandleAt(uint32_t dense) const
+    {
+        uint32_t index = denseToSlot[dense];
+        return {index, slots[index].generation};
+    }
+
+    /** @brief Number of live handles */
+    inline size_t Size() const
+    {
+        return denseToSlot.size();
+    }
+
+    /** @brief Number of slots ever allocated (live or free) */
+    inline size_t SlotCount() const
+    {
+        return slots.size();
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t dense = Handle::NULL_INDEX;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<uint32_t> freeList;
+};
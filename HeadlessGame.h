@@ -0,0 +1,185 @@
+#pragma once
+
+#include "AsciiGame.h"
+#include "GLGame.h"
+#include "Game.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+// Headless run statistics
+//------------------------------------------------------------------------------
+
+/** @brief Result of RunHeadless: how many ticks ran and how long they took */
+struct HeadlessStats
+{
+    uint64_t ticks = 0;
+    /** @brief Wall time spent stepping the game, excluding construction and Initialize */
+    double seconds = 0;
+
+    inline double TicksPerSecond() const
+    {
+        return seconds > 0 ? ticks / seconds : 0;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Headless runner
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Owns a game of type `G` wired to null graphics backends, and steps it
+ * as fast as possible: no window, no terminal output and no frame pacing.
+ * The game gets the same bounds as under `PlayGame`, and is bound to the
+ * calling thread only while it is being constructed or run, so runners can
+ * live on (and move between) any threads.
+ */
+template <IsGame G>
+class HeadlessRunner
+{
+public:
+    explicit HeadlessRunner(uint64_t seed = DEFAULT_WORLD_SEED)
+    {
+        {
+            WorldScope boundsScope{DefaultBounds<G>()};
+            if constexpr (std::is_base_of_v<AsciiGame, G>)
+            {
+                game = std::make_unique<G>(&backend.graphics);
+            }
+            else if constexpr (std::is_base_of_v<GLGame, G>)
+            {
+                game = std::make_unique<G>(&backend.graphics);
+            }
+            else
+            {
+                game = std::make_unique<G>();
+            }
+        }
+
+        WorldScope scope{*game};
+        game->Seed(seed);
+        game->Initialize();
+    }
+
+    HeadlessRunner(const HeadlessRunner &) = delete;
+    HeadlessRunner &operator=(const HeadlessRunner &) = delete;
+
+    /**
+     * @brief Run `ticks` back-to-back Update calls, each followed by a Draw
+     * unless `draw` is false. Returns the stats of this run only.
+     */
+    inline HeadlessStats Run(uint64_t ticks, bool draw = true)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        WorldScope scope{*game};
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < ticks; i++)
+        {
+            game->Update();
+            if (draw)
+            {
+                game->Draw();
+            }
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        return {ticks, elapsed.count()};
+    }
+
+    inline G &GetGame()
+    {
+        return *game;
+    }
+
+private:
+    struct AsciiBackend
+    {
+        NullOStream stream;
+        AsciiGraphics graphics{stream};
+    };
+    struct GLBackend
+    {
+        GLGraphics graphics{kGLBackendNull};
+    };
+    struct NoBackend
+    {
+    };
+    // Only the backend G draws with is built, so ASCII games never reference GL
+    using Backend = std::conditional_t<std::is_base_of_v<AsciiGame, G>, AsciiBackend,
+                                       std::conditional_t<std::is_base_of_v<GLGame, G>, GLBackend, NoBackend>>;
+
+    // Declared first so it outlives the game
+    Backend backend;
+    std::unique_ptr<G> game;
+};
+
+/** @brief Construct `G` headless and step it `ticks` times, uncapped */
+template <IsGame G>
+HeadlessStats RunHeadless(uint64_t ticks, bool draw = true, uint64_t seed = DEFAULT_WORLD_SEED)
+{
+    HeadlessRunner<G> runner{seed};
+    return runner.Run(ticks, draw);
+}
+
+//------------------------------------------------------------------------------
+// Batch runner
+//------------------------------------------------------------------------------
+
+/** @brief Aggregate result of RunBatch */
+struct BatchStats
+{
+    uint64_t worlds = 0;
+    uint64_t ticksPerWorld = 0;
+    /** @brief Wall time for the whole batch, including constructing and initializing worlds */
+    double seconds = 0;
+
+    inline uint64_t TotalTicks() const
+    {
+        return worlds * ticksPerWorld;
+    }
+
+    inline double TicksPerSecond() const
+    {
+        return seconds > 0 ? TotalTicks() / seconds : 0;
+    }
+};
+
+/**
+ * @brief Run `worlds` independent headless games of type `G` for `ticks` ticks
+ * each, spread across `pool`. World `i` is seeded with `seed + i`, so a batch
+ * is reproducible regardless of thread count or scheduling.
+ *
+ * `collect(i, game)` is called once per world after its last tick, on the
+ * worker that ran it and with the world still bound. Calls run concurrently,
+ * so it should only write to per-world slots (e.g. `results[i]`).
+ *
+ * Worlds share nothing, so throughput scales with the number of cores.
+ */
+template <IsGame G, typename CollectFn>
+    requires std::is_invocable_v<CollectFn &, size_t, G &>
+BatchStats RunBatch(ThreadPool &pool, size_t worlds, uint64_t ticks, CollectFn &&collect,
+                    uint64_t seed = DEFAULT_WORLD_SEED, bool draw = false)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start = Clock::now();
+    pool.ParallelFor(worlds, [&](size_t i)
+                     {
+                         HeadlessRunner<G> runner{seed + i};
+                         runner.Run(ticks, draw);
+
+                         WorldScope scope{runner.GetGame()};
+                         collect(i, runner.GetGame()); });
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return {worlds, ticks, elapsed.count()};
+}
+
+template <IsGame G>
+BatchStats RunBatch(ThreadPool &pool, size_t worlds, uint64_t ticks,
+                    uint64_t seed = DEFAULT_WORLD_SEED, bool draw = false)
+{
+    return RunBatch<G>(pool, worlds, ticks, [](size_t, G &) {}, seed, draw);
+}
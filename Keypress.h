@@ -28,16 +28,30 @@ constexpr size_t MAX_EVENTS = 128;
 
 /**
  * KeyEventManager implementation
+ *
+ * Every world (Game) owns its own manager. GetInstance() returns the one bound
+ * to the calling thread, so worlds stepped on different threads never share
+ * key state; threads with nothing bound fall back to a process-wide default.
  */
 
 class KeyEventManager
 {
 public:
-    // Public method to access the singleton instance
+    KeyEventManager() {}
+    ~KeyEventManager() {};
+
+    // Manager bound to the calling thread
     inline static KeyEventManager &GetInstance()
     {
-        static KeyEventManager instance; // This is the single instance
-        return instance;
+        return current != nullptr ? *current : Default_();
+    }
+
+    /** @brief Bind `manager` to the calling thread (nullptr for the default). Returns the previous binding */
+    inline static KeyEventManager *Bind(KeyEventManager *manager)
+    {
+        KeyEventManager *previous = current;
+        current = manager;
+        return previous;
     }
 
     // Consume events
@@ -120,14 +134,19 @@ private:
     KeyEvent events[MAX_EVENTS];
     size_t numEvents = 0;
 
-    bool isKeyDown[kKeyCodeMax];
-    bool isKeyUp[kKeyCodeMax];
-    bool isKeyPressed[kKeyCodeMax];
+    bool isKeyDown[kKeyCodeMax]{};
+    bool isKeyUp[kKeyCodeMax]{};
+    bool isKeyPressed[kKeyCodeMax]{};
 
     uint lastFrameCount = 0;
-    // Private constructor to prevent direct instantiation
-    KeyEventManager() {}
-    ~KeyEventManager() {};
+
+    inline static KeyEventManager &Default_()
+    {
+        static KeyEventManager instance;
+        return instance;
+    }
+
+    inline static thread_local KeyEventManager *current = nullptr;
 };
 
 void key_callback(GLFWwindow *, int key, int, int action, int)
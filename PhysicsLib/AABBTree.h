@@ -0,0 +1,641 @@
+// aabbtree.h
+
+#pragma once
+
+#include "../UnitLib/Vector.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+constexpr int32_t AABB_NULL_NODE = -1;
+/** @brief Default amount each leaf box is grown by on every side */
+constexpr double AABB_TREE_MARGIN = 0.1;
+/** @brief Leaves are also stretched this many displacements ahead of a moving box */
+constexpr double AABB_TREE_DISPLACEMENT_MULTIPLIER = 2.0;
+
+//------------------------------------------------------------------------------
+// AABB helpers
+//------------------------------------------------------------------------------
+
+/** @brief True if `outer` fully contains `inner` */
+inline bool Contains(const AABB &outer, const AABB &inner)
+{
+    return outer.x <= inner.x && outer.y <= inner.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+/** @brief `a` grown by `margin` on every side */
+inline AABB Fatten(const AABB &a, double margin)
+{
+    return {a.x - margin, a.y - margin, a.width + 2 * margin, a.height + 2 * margin};
+}
+
+//------------------------------------------------------------------------------
+// AABBTree definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Dynamic bounding volume hierarchy over AABBs.
+ * - Leaves store a "fat" box: the real box grown by a margin and stretched
+ *   along the predicted displacement, so small moves don't touch the tree
+ * - Insertion walks down choosing the child with the smallest perimeter
+ *   increase; AVL-style rotations keep the tree balanced
+ * - Nodes live in one array with a free list; proxy ids stay stable until
+ *   the proxy is removed
+ *
+ * Queries run against the fat boxes, so they report candidates that an exact
+ * test (e.g. CheckCollision) should confirm. Queries don't modify the tree, so
+ * any number of threads may query it at once.
+ */
+template <typename Data = void *>
+class AABBTree
+{
+public:
+    explicit AABBTree(double margin_ = AABB_TREE_MARGIN) : margin{margin_} {};
+
+    /** @brief Add a box, returning its proxy id */
+    inline int32_t Insert(const AABB &box, Data data)
+    {
+        int32_t proxy = AllocateNode_();
+        nodes[proxy].box = AABBBounds::From(Fatten(box, margin));
+        nodes[proxy].data = std::move(data);
+        nodes[proxy].height = 0;
+        InsertLeaf_(proxy);
+        proxyCount++;
+        return proxy;
+    }
+
+    inline void Remove(int32_t proxy)
+    {
+        CheckProxy_(proxy);
+        RemoveLeaf_(proxy);
+        FreeNode_(proxy);
+        proxyCount--;
+    }
+
+    /**
+     * @brief Update a proxy after its box moved by `displacement`. Returns true
+     * if the leaf had to be reinserted, false if the fat box still covered it.
+     */
+    inline bool Move(int32_t proxy, const AABB &box, const Vector2<double> &displacement = Vector2<double>{})
+    {
+        CheckProxy_(proxy);
+        if (nodes[proxy].box.Contains(AABBBounds::From(box)))
+        {
+            return false;
+        }
+
+        AABBBounds fat = AABBBounds::From(Fatten(box, margin));
+        double dx = AABB_TREE_DISPLACEMENT_MULTIPLIER * displacement.x();
+        double dy = AABB_TREE_DISPLACEMENT_MULTIPLIER * displacement.y();
+        (dx < 0 ? fat.minX : fat.maxX) += dx;
+        (dy < 0 ? fat.minY : fat.maxY) += dy;
+
+        RemoveLeaf_(proxy);
+        nodes[proxy].box = fat;
+        InsertLeaf_(proxy);
+        return true;
+    }
+
+    inline Data &GetData(int32_t proxy)
+    {
+        CheckProxy_(proxy);
+        return nodes[proxy].data;
+    }
+
+    inline AABB GetFatAABB(int32_t proxy) const
+    {
+        CheckProxy_(proxy);
+        return nodes[proxy].box.ToAABB();
+    }
+
+    /** @brief Number of proxies in the tree */
+    inline size_t Size() const
+    {
+        return proxyCount;
+    }
+
+    /** @brief Height of the tree; a single leaf has height 0 */
+    inline int32_t Height() const
+    {
+        return root == AABB_NULL_NODE ? 0 : nodes[root].height;
+    }
+
+    /**
+     * @brief Call `fn(proxy)` for every proxy whose fat box overlaps `region`.
+     * If `fn` returns bool, returning false stops the query.
+     */
+    template <typename Fn>
+    inline void Query(const AABB &region, Fn &&fn) const
+    {
+        if (root == AABB_NULL_NODE)
+        {
+            return;
+        }
+
+        const AABBBounds bounds = AABBBounds::From(region);
+        TraversalStack_ stack{root};
+        while (!stack.Empty())
+        {
+            int32_t index = stack.Pop();
+
+            const Node &node = nodes[index];
+            if (!node.box.Overlaps(bounds))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                if (!Continue_(fn, index))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    /** @brief Call `fn(proxyA, proxyB)` once for every pair of proxies whose fat boxes overlap */
+    template <typename Fn>
+    inline void QueryPairs(Fn &&fn) const
+    {
+        if (root == AABB_NULL_NODE || nodes[root].IsLeaf())
+        {
+            return;
+        }
+        PairsWithin_(root, fn);
+    }
+
+    /**
+     * @brief Cast the segment `from` -> `to` through the tree. For each proxy
+     * whose fat box the remaining segment crosses, `fn(proxy, maxFraction)` is
+     * called and returns the new max fraction along the segment: the fraction
+     * of an exact hit to clip the ray there, `maxFraction` to keep going, or 0
+     * to stop.
+     */
+    template <typename Fn>
+    inline void RayCast(const Vector2<double> &from, const Vector2<double> &to, Fn &&fn) const
+    {
+        if (root == AABB_NULL_NODE)
+        {
+            return;
+        }
+
+        double maxFraction = 1;
+        TraversalStack_ stack{root};
+        while (!stack.Empty())
+        {
+            int32_t index = stack.Pop();
+
+            const Node &node = nodes[index];
+            if (!SegmentHits_(node.box, from, to, maxFraction))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                double fraction = fn(index, maxFraction);
+                if (fraction <= 0)
+                {
+                    return;
+                }
+                maxFraction = std::min(maxFraction, fraction);
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    /** @brief Check parent links, heights and that every parent encloses its children */
+    inline bool Validate() const
+    {
+        if (root == AABB_NULL_NODE)
+        {
+            return proxyCount == 0;
+        }
+        size_t leaves = 0;
+        return nodes[root].parent == AABB_NULL_NODE && Validate_(root, leaves) && leaves == proxyCount;
+    }
+
+private:
+    struct Node
+    {
+        AABBBounds box{};
+        Data data{};
+        int32_t parent = AABB_NULL_NODE; // Doubles as the free list link for unused nodes
+        int32_t child1 = AABB_NULL_NODE;
+        int32_t child2 = AABB_NULL_NODE;
+        int32_t height = -1;             // -1 for unused nodes
+
+        inline bool IsLeaf() const
+        {
+            return child1 == AABB_NULL_NODE;
+        }
+    };
+
+    /** @brief DFS stack that lives on the call stack until it outgrows its inline buffer */
+    struct TraversalStack_
+    {
+        static constexpr size_t INLINE_SIZE = 64;
+
+        explicit TraversalStack_(int32_t first)
+        {
+            Push(first);
+        }
+
+        inline void Push(int32_t index)
+        {
+            if (size < INLINE_SIZE)
+            {
+                buffer[size] = index;
+            }
+            else
+            {
+                overflow.push_back(index);
+            }
+            size++;
+        }
+
+        inline int32_t Pop()
+        {
+            size--;
+            if (size < INLINE_SIZE)
+            {
+                return buffer[size];
+            }
+            int32_t index = overflow.back();
+            overflow.pop_back();
+            return index;
+        }
+
+        inline bool Empty() const
+        {
+            return size == 0;
+        }
+
+        int32_t buffer[INLINE_SIZE];
+        std::vector<int32_t> overflow;
+        size_t size = 0;
+    };
+
+    template <typename Fn>
+    inline static bool Continue_(Fn &fn, int32_t proxy)
+    {
+        if constexpr (std::is_same_v<std::invoke_result_t<Fn &, int32_t>, bool>)
+        {
+            return fn(proxy);
+        }
+        else
+        {
+            fn(proxy);
+            return true;
+        }
+    }
+
+    inline void CheckProxy_(int32_t proxy) const
+    {
+        if (proxy < 0 || proxy >= static_cast<int32_t>(nodes.size()) || nodes[proxy].height != 0)
+        {
+            throw std::runtime_error("Invalid AABBTree proxy");
+        }
+    }
+
+    inline int32_t AllocateNode_()
+    {
+        int32_t index;
+        if (freeList != AABB_NULL_NODE)
+        {
+            index = freeList;
+            freeList = nodes[index].parent;
+            nodes[index] = Node{};
+        }
+        else
+        {
+            index = static_cast<int32_t>(nodes.size());
+            nodes.push_back(Node{});
+        }
+        return index;
+    }
+
+    inline void FreeNode_(int32_t index)
+    {
+        nodes[index] = Node{};
+        nodes[index].parent = freeList;
+        freeList = index;
+    }
+
+    inline void InsertLeaf_(int32_t leaf)
+    {
+        nodes[leaf].parent = AABB_NULL_NODE;
+        if (root == AABB_NULL_NODE)
+        {
+            root = leaf;
+            return;
+        }
+
+        // Find the best sibling: descend while it is cheaper than pairing here
+        const AABBBounds leafBox = nodes[leaf].box;
+        int32_t index = root;
+        while (!nodes[index].IsLeaf())
+        {
+            const Node &node = nodes[index];
+            double area = node.box.Perimeter();
+            double combined = node.box.Union(leafBox).Perimeter();
+
+            // Cost of making a new parent for this node and the leaf
+            double cost = 2 * combined;
+            // Minimum cost of pushing the leaf further down
+            double inheritance = 2 * (combined - area);
+
+            double cost1 = DescendCost_(node.child1, leafBox) + inheritance;
+            double cost2 = DescendCost_(node.child2, leafBox) + inheritance;
+
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        // Make a new parent for the sibling and the leaf
+        int32_t sibling = index;
+        int32_t oldParent = nodes[sibling].parent;
+        int32_t newParent = AllocateNode_();
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].box = leafBox.Union(nodes[sibling].box);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].child1 = sibling;
+        nodes[newParent].child2 = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent == AABB_NULL_NODE)
+        {
+            root = newParent;
+        }
+        else if (nodes[oldParent].child1 == sibling)
+        {
+            nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            nodes[oldParent].child2 = newParent;
+        }
+
+        Refit_(nodes[leaf].parent);
+    }
+
+    inline double DescendCost_(int32_t child, const AABBBounds &leafBox) const
+    {
+        double combined = leafBox.Union(nodes[child].box).Perimeter();
+        if (nodes[child].IsLeaf())
+        {
+            return combined;
+        }
+        return combined - nodes[child].box.Perimeter();
+    }
+
+    inline void RemoveLeaf_(int32_t leaf)
+    {
+        if (leaf == root)
+        {
+            root = AABB_NULL_NODE;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grandParent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grandParent == AABB_NULL_NODE)
+        {
+            root = sibling;
+            nodes[sibling].parent = AABB_NULL_NODE;
+            FreeNode_(parent);
+            return;
+        }
+
+        // Splice the sibling into the parent's place
+        if (nodes[grandParent].child1 == parent)
+        {
+            nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            nodes[grandParent].child2 = sibling;
+        }
+        nodes[sibling].parent = grandParent;
+        FreeNode_(parent);
+
+        Refit_(grandParent);
+    }
+
+    /** @brief Walk up from `index`, rebalancing and recomputing heights and boxes */
+    inline void Refit_(int32_t index)
+    {
+        while (index != AABB_NULL_NODE)
+        {
+            index = Balance_(index);
+
+            Node &node = nodes[index];
+            node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+            node.box = nodes[node.child1].box.Union(nodes[node.child2].box);
+
+            index = node.parent;
+        }
+    }
+
+    /**
+     * @brief If `a`'s subtrees differ in height by more than one, rotate the
+     * taller child up into `a`'s place. Returns the root of the subtree.
+     */
+    inline int32_t Balance_(int32_t a)
+    {
+        if (nodes[a].IsLeaf() || nodes[a].height < 2)
+        {
+            return a;
+        }
+
+        int32_t b = nodes[a].child1;
+        int32_t c = nodes[a].child2;
+        int32_t balance = nodes[c].height - nodes[b].height;
+
+        if (balance > 1)
+        {
+            return Rotate_(a, c, b);
+        }
+        if (balance < -1)
+        {
+            return Rotate_(a, b, c);
+        }
+        return a;
+    }
+
+    /** @brief Rotate `up` (a child of `a`) above `a`; `other` is `a`'s remaining child */
+    inline int32_t Rotate_(int32_t a, int32_t up, int32_t other)
+    {
+        int32_t f = nodes[up].child1;
+        int32_t g = nodes[up].child2;
+
+        // `up` takes `a`'s place
+        nodes[up].child1 = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        int32_t upParent = nodes[up].parent;
+        if (upParent == AABB_NULL_NODE)
+        {
+            root = up;
+        }
+        else if (nodes[upParent].child1 == a)
+        {
+            nodes[upParent].child1 = up;
+        }
+        else
+        {
+            nodes[upParent].child2 = up;
+        }
+
+        // The taller grandchild stays under `up`, the shorter one moves under `a`
+        if (nodes[f].height < nodes[g].height)
+        {
+            std::swap(f, g);
+        }
+        nodes[up].child2 = f;
+        if (nodes[a].child1 == up)
+        {
+            nodes[a].child1 = g;
+        }
+        else
+        {
+            nodes[a].child2 = g;
+        }
+        nodes[g].parent = a;
+
+        nodes[a].box = nodes[other].box.Union(nodes[g].box);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[g].height);
+        nodes[up].box = nodes[a].box.Union(nodes[f].box);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[f].height);
+        return up;
+    }
+
+    /** @brief Report overlapping leaf pairs inside the subtree at `index` */
+    template <typename Fn>
+    inline void PairsWithin_(int32_t index, Fn &fn) const
+    {
+        const Node &node = nodes[index];
+        if (node.IsLeaf())
+        {
+            return;
+        }
+        PairsWithin_(node.child1, fn);
+        PairsWithin_(node.child2, fn);
+        PairsBetween_(node.child1, node.child2, fn);
+    }
+
+    /** @brief Report overlapping leaf pairs with one leaf under `a` and the other under `b` */
+    template <typename Fn>
+    inline void PairsBetween_(int32_t a, int32_t b, Fn &fn) const
+    {
+        const Node &na = nodes[a];
+        const Node &nb = nodes[b];
+        if (!na.box.Overlaps(nb.box))
+        {
+            return;
+        }
+
+        if (na.IsLeaf() && nb.IsLeaf())
+        {
+            fn(std::min(a, b), std::max(a, b));
+        }
+        else if (nb.IsLeaf() || (!na.IsLeaf() && na.height >= nb.height))
+        {
+            PairsBetween_(na.child1, b, fn);
+            PairsBetween_(na.child2, b, fn);
+        }
+        else
+        {
+            PairsBetween_(a, nb.child1, fn);
+            PairsBetween_(a, nb.child2, fn);
+        }
+    }
+
+    /** @brief Slab test: does the segment from -> from + (to - from) * maxFraction touch `box`? */
+    inline static bool SegmentHits_(const AABBBounds &box, const Vector2<double> &from, const Vector2<double> &to, double maxFraction)
+    {
+        double tMin = 0;
+        double tMax = maxFraction;
+
+        const double origin[2] = {from.x(), from.y()};
+        const double delta[2] = {to.x() - from.x(), to.y() - from.y()};
+        const double lo[2] = {box.minX, box.minY};
+        const double hi[2] = {box.maxX, box.maxY};
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            if (delta[axis] == 0)
+            {
+                if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            double inv = 1 / delta[axis];
+            double t1 = (lo[axis] - origin[axis]) * inv;
+            double t2 = (hi[axis] - origin[axis]) * inv;
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline bool Validate_(int32_t index, size_t &leaves) const
+    {
+        const Node &node = nodes[index];
+        if (node.IsLeaf())
+        {
+            leaves++;
+            return node.height == 0 && node.child2 == AABB_NULL_NODE;
+        }
+
+        const Node &c1 = nodes[node.child1];
+        const Node &c2 = nodes[node.child2];
+        return c1.parent == index && c2.parent == index &&
+               node.height == 1 + std::max(c1.height, c2.height) &&
+               node.box.Contains(c1.box) && node.box.Contains(c2.box) &&
+               Validate_(node.child1, leaves) && Validate_(node.child2, leaves);
+    }
+
+    std::vector<Node> nodes;
+    int32_t root = AABB_NULL_NODE;
+    int32_t freeList = AABB_NULL_NODE;
+    size_t proxyCount = 0;
+    double margin;
+};
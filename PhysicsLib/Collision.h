@@ -2,15 +2,160 @@
 
 #pragma once
 
-struct AABB {
-    double x;
-    double y;
-    double width;
-    double height;
+#include "../UnitLib/Unit.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Plain number type underlying a coordinate: the type itself for
+ * arithmetic types, the stored type for Units. Raw() reads the stored value
+ * without conversion, so it is free.
+ */
+template <typename Coord>
+struct CoordTraits {
+    using Scalar = Coord;
+
+    inline static Scalar Raw(const Coord& c) {
+        return c;
+    }
+};
+
+template <typename Type, UnitIdentifier UID, IsRatio Ratio>
+struct CoordTraits<Unit<Type, UID, Ratio>> {
+    using Scalar = Type;
+
+    inline static Scalar Raw(const Unit<Type, UID, Ratio>& c) {
+        return c.GetValue();
+    }
+};
+
+template <typename Coord>
+using CoordScalar = typename CoordTraits<Coord>::Scalar;
+
+/**
+ * @brief Axis-aligned box with the given coordinate type, e.g. double or a
+ * UnitLib length such as Worldspace. Unit-typed boxes have the same layout as
+ * AABB and compile to the same code.
+ */
+template <typename Coord = double>
+struct BasicAABB {
+    Coord x;
+    Coord y;
+    Coord width;
+    Coord height;
+};
+
+/** @brief Box in plain doubles; the type the broadphases work in */
+using AABB = BasicAABB<double>;
+
+/** @brief The same box in plain doubles, for handing unit-typed boxes to the broadphases */
+template <typename Coord>
+inline AABB ToRawAABB(const BasicAABB<Coord>& a) {
+    using Traits = CoordTraits<Coord>;
+    return {static_cast<double>(Traits::Raw(a.x)), static_cast<double>(Traits::Raw(a.y)),
+            static_cast<double>(Traits::Raw(a.width)), static_cast<double>(Traits::Raw(a.height))};
+}
+
+template <typename Coord>
+inline bool CheckCollision(const BasicAABB<Coord>& a, const BasicAABB<Coord>& b) {
+    // Bitwise ors: all four tests are cheap, and skipping branches avoids mispredicts
+    return !((a.x + a.width < b.x) | (a.x > b.x + b.width) |
+             (a.y + a.height < b.y) | (a.y > b.y + b.height));
+}
+
+/** @brief Result of SweepAABB */
+struct TimeOfImpact {
+    bool hit = false;
+    /** @brief Fraction of the displacement travelled before contact, in [0, 1] */
+    double time = 1.0;
+    /** @brief Surface normal of the face that was hit, pointing back at the moving box */
+    double normalX = 0.0;
+    double normalY = 0.0;
 };
 
-inline bool CheckCollision(const AABB& a, const AABB& b) {
-    return !(a.x + a.width < b.x || a.x > b.x + b.width ||
-             a.y + a.height < b.y || a.y > b.y + b.height);
+/** @brief Entry and exit times of a 1D interval moving by `d` against a static one */
+inline void SweepAxis_(double movingMin, double movingMax, double d, double targetMin, double targetMax,
+                       double &entry, double &exit) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    if (d > 0) {
+        entry = (targetMin - movingMax) / d;
+        exit = (targetMax - movingMin) / d;
+    } else if (d < 0) {
+        entry = (targetMax - movingMin) / d;
+        exit = (targetMin - movingMax) / d;
+    } else if (movingMax < targetMin || movingMin > targetMax) {
+        entry = inf;
+        exit = -inf;
+    } else {
+        entry = -inf;
+        exit = inf;
+    }
 }
 
+/**
+ * @brief Sweep `moving` by (dx, dy) against the static box `target` and find
+ * the first contact, so fast boxes can't pass through thin ones between
+ * steps. Touching counts as contact, as in CheckCollision. Boxes already
+ * overlapping at the start are not reported: that is left to the discrete
+ * test, and lets a box that is stuck inside another move out.
+ */
+inline TimeOfImpact SweepAABB(const AABB& moving, double dx, double dy, const AABB& target) {
+    double entryX, exitX, entryY, exitY;
+    SweepAxis_(moving.x, moving.x + moving.width, dx, target.x, target.x + target.width, entryX, exitX);
+    SweepAxis_(moving.y, moving.y + moving.height, dy, target.y, target.y + target.height, entryY, exitY);
+
+    double entry = std::max(entryX, entryY);
+    double exit = std::min(exitX, exitY);
+    if (entry > exit || entry < 0 || entry > 1) {
+        return {};
+    }
+
+    TimeOfImpact result{true, entry};
+    if (entryX >= entryY) {
+        result.normalX = dx > 0 ? -1.0 : 1.0;
+    } else {
+        result.normalY = dy > 0 ? -1.0 : 1.0;
+    }
+    return result;
+}
+
+/**
+ * @brief Min/max form of an AABB. Broadphases store boxes this way so unions
+ * and containment are exact, with no rounding from recomputing widths.
+ */
+struct AABBBounds
+{
+    double minX, minY, maxX, maxY;
+
+    inline static AABBBounds From(const AABB &a)
+    {
+        return {a.x, a.y, a.x + a.width, a.y + a.height};
+    }
+
+    inline AABB ToAABB() const
+    {
+        return {minX, minY, maxX - minX, maxY - minY};
+    }
+
+    inline AABBBounds Union(const AABBBounds &b) const
+    {
+        return {std::min(minX, b.minX), std::min(minY, b.minY), std::max(maxX, b.maxX), std::max(maxY, b.maxY)};
+    }
+
+    inline bool Contains(const AABBBounds &b) const
+    {
+        return minX <= b.minX && minY <= b.minY && b.maxX <= maxX && b.maxY <= maxY;
+    }
+
+    /** @brief Same edge semantics as CheckCollision: touching boxes overlap */
+    inline bool Overlaps(const AABBBounds &b) const
+    {
+        return !(maxX < b.minX || minX > b.maxX || maxY < b.minY || minY > b.maxY);
+    }
+
+    /** @brief The cost metric used to pick where leaves are inserted */
+    inline double Perimeter() const
+    {
+        return 2 * ((maxX - minX) + (maxY - minY));
+    }
+};
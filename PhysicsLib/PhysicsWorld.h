@@ -0,0 +1,244 @@
+// physicsworld.h
+
+#pragma once
+
+#include "../ThreadPool.h"
+#include "Actor.h"
+#include "Collision.h"
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+/** @brief Actors integrated per task; a multiple of Actor::UpdateAll's chunk, so results never depend on the split */
+constexpr size_t PHYSICS_INTEGRATE_GRAIN = 1024;
+/** @brief Candidate pairs tested per narrowphase task */
+constexpr size_t PHYSICS_PAIR_GRAIN = 256;
+
+//------------------------------------------------------------------------------
+// Collision events
+//------------------------------------------------------------------------------
+
+/** @brief A contact that began during PhysicsWorld::Step */
+struct CollisionEvent
+{
+    /** @brief Indices of the two actors, a < b */
+    uint32_t a;
+    uint32_t b;
+    /** @brief Unit normal pointing from a to b, along the axis of least penetration */
+    double normalX;
+    double normalY;
+    double depth;
+};
+
+/** @brief Contact between two overlapping boxes; the normal points from `a` to `b` */
+inline CollisionEvent AABBContact(const AABB &a, const AABB &b)
+{
+    double overlapX = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+    double overlapY = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+    double dx = (b.x + b.width / 2) - (a.x + a.width / 2);
+    double dy = (b.y + b.height / 2) - (a.y + a.height / 2);
+    if (overlapX < overlapY)
+    {
+        return {0, 0, dx < 0 ? -1.0 : 1.0, 0.0, overlapX};
+    }
+    return {0, 0, 0.0, dy < 0 ? -1.0 : 1.0, overlapY};
+}
+
+//------------------------------------------------------------------------------
+// PhysicsWorld definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Owns a set of Actors in one contiguous array and steps them together.
+ * Each Step runs four stages:
+ * - Integrate: Actor::UpdateAll over fixed-size slices, in parallel
+ * - Broadphase: a SweepAndPrune over every bounding box, finding the pairs
+ *   that started overlapping this step
+ * - Narrowphase: the contact normal and depth of each new pair, in parallel
+ * - Response: every new contact appended to the event buffer, then
+ *   Actor::Rebound once for each actor in at least one of them, so an actor
+ *   hit by several others in one step is not reversed back into them
+ *
+ * Work is split into slices of a fixed size rather than one per thread, and
+ * pairs are processed in sorted order, so results are bit-identical for any
+ * pool size, including no pool at all. Nothing is printed while stepping;
+ * read GetEvents() or call DispatchEvents() afterwards to react to contacts.
+ */
+template <typename T, typename Time = T>
+class PhysicsWorld
+{
+public:
+    using ActorType = Actor<T, Time>;
+
+    /** @brief Step on `pool_`, or on the calling thread if it is null */
+    explicit PhysicsWorld(ThreadPool *pool_ = nullptr)
+        : pool(pool_)
+    {
+    }
+
+    /** @brief Add a copy of `actor`, returning its index */
+    inline size_t Add(const ActorType &actor)
+    {
+        if (actor.proxy != SAP_NULL_PROXY)
+        {
+            throw std::runtime_error("Actor is already registered with a broadphase");
+        }
+        uint32_t index = static_cast<uint32_t>(actors.size());
+        actors.push_back(actor);
+        actors.back().proxy = broadphase.Insert(ToRawAABB(actor.boundingBox), index);
+        return index;
+    }
+
+    inline ActorType &Get(size_t index)
+    {
+        CheckIndex_(index);
+        return actors[index];
+    }
+
+    inline const ActorType &Get(size_t index) const
+    {
+        CheckIndex_(index);
+        return actors[index];
+    }
+
+    inline std::span<ActorType> GetActors()
+    {
+        return actors;
+    }
+
+    inline size_t Size() const
+    {
+        return actors.size();
+    }
+
+    /** @brief Advance every actor by `deltaTime` and resolve the contacts that begin */
+    inline void Step(Time deltaTime)
+    {
+        events.clear();
+        Integrate_(deltaTime);
+        Broadphase_();
+        Narrowphase_();
+        Respond_();
+    }
+
+    /** @brief Contacts that began during the last Step, ordered by (a, b) */
+    inline const std::vector<CollisionEvent> &GetEvents() const
+    {
+        return events;
+    }
+
+    /** @brief Call `fn(event, actorA, actorB)` for every event of the last Step, in order */
+    template <typename Fn>
+    inline void DispatchEvents(Fn &&fn)
+    {
+        for (const CollisionEvent &event : events)
+        {
+            fn(event, actors[event.a], actors[event.b]);
+        }
+    }
+
+private:
+    /** @brief Run `fn(begin, end)` over [0, n) in slices of `grain`, on the pool if there is one */
+    template <typename Fn>
+    inline void ForEachSlice_(size_t n, size_t grain, Fn &&fn)
+    {
+        size_t slices = (n + grain - 1) / grain;
+        auto run = [&](size_t slice)
+        {
+            size_t begin = slice * grain;
+            fn(begin, std::min(n, begin + grain));
+        };
+
+        if (pool == nullptr || slices <= 1)
+        {
+            for (size_t slice = 0; slice < slices; slice++)
+            {
+                run(slice);
+            }
+            return;
+        }
+        pool->ParallelFor(slices, run);
+    }
+
+    inline void Integrate_(Time deltaTime)
+    {
+        std::span<ActorType> all{actors};
+        ForEachSlice_(actors.size(), PHYSICS_INTEGRATE_GRAIN, [&](size_t begin, size_t end)
+                      { ActorType::UpdateAll(all.subspan(begin, end - begin), deltaTime); });
+    }
+
+    inline void Broadphase_()
+    {
+        for (const ActorType &actor : actors)
+        {
+            broadphase.Move(actor.proxy, ToRawAABB(actor.boundingBox));
+        }
+        broadphase.Update();
+
+        // Sorted by actor index, so the response order is fixed whatever the broadphase reports first
+        pairs.clear();
+        for (const auto &[a, b] : broadphase.GetBegan())
+        {
+            pairs.push_back({broadphase.GetData(a), broadphase.GetData(b)});
+        }
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+    inline void Narrowphase_()
+    {
+        contacts.resize(pairs.size());
+        ForEachSlice_(pairs.size(), PHYSICS_PAIR_GRAIN, [&](size_t begin, size_t end)
+                      {
+                          for (size_t i = begin; i < end; i++)
+                          {
+                              auto [a, b] = pairs[i];
+                              contacts[i] = AABBContact(ToRawAABB(actors[a].boundingBox), ToRawAABB(actors[b].boundingBox));
+                              contacts[i].a = a;
+                              contacts[i].b = b;
+                          } });
+    }
+
+    inline void Respond_()
+    {
+        touched.clear();
+        for (const CollisionEvent &contact : contacts)
+        {
+            touched.push_back(contact.a);
+            touched.push_back(contact.b);
+            events.push_back(contact);
+        }
+
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (uint32_t index : touched)
+        {
+            actors[index].state = ActorState::Colliding;
+            actors[index].Rebound();
+        }
+    }
+
+    inline void CheckIndex_(size_t index) const
+    {
+        if (index >= actors.size())
+        {
+            throw std::runtime_error("PhysicsWorld actor index out of range");
+        }
+    }
+
+    ThreadPool *pool;
+    std::vector<ActorType> actors;
+    SweepAndPrune<uint32_t> broadphase;
+
+    // Per-step scratch, kept to avoid reallocating every step
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<CollisionEvent> contacts;
+    std::vector<uint32_t> touched;
+    std::vector<CollisionEvent> events;
+};
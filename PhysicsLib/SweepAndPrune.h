@@ -0,0 +1,384 @@
+// sweepandprune.h
+
+#pragma once
+
+#include "Collision.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+constexpr int32_t SAP_NULL_PROXY = -1;
+
+//------------------------------------------------------------------------------
+// SweepAndPrune definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Incremental sweep-and-prune broadphase, for scenes where most boxes
+ * move a little every tick.
+ * - The min/max endpoints of every box are kept sorted along x and y between
+ *   ticks. Update() restores the order with insertion sort, which is close to
+ *   O(N) when the order barely changed since the last tick
+ * - Every swap of a min past a max starts or ends an overlap on that axis, so
+ *   the set of overlapping pairs is maintained from swaps alone, without ever
+ *   testing all pairs
+ * - Update() also reports which pairs began and ended overlapping since the
+ *   previous Update(), so contact responses can run once per contact rather
+ *   than once per tick
+ *
+ * Moves and inserts take effect at the next Update(). Inserting many boxes at
+ * once costs O(N) each, since new endpoints are sorted in from the end.
+ */
+template <typename Data = void *>
+class SweepAndPrune
+{
+public:
+    using Pair = std::pair<int32_t, int32_t>;
+
+    /** @brief Add a box, returning its proxy id. It is paired up at the next Update() */
+    inline int32_t Insert(const AABB &box, Data data)
+    {
+        int32_t proxy;
+        if (freeList.empty())
+        {
+            proxy = static_cast<int32_t>(proxies.size());
+            proxies.emplace_back();
+        }
+        else
+        {
+            proxy = freeList.back();
+            freeList.pop_back();
+        }
+
+        Proxy &p = proxies[proxy];
+        p.box = AABBBounds::From(box);
+        p.data = std::move(data);
+        p.alive = true;
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            std::vector<Endpoint> &ends = axes[axis];
+            p.minIndex[axis] = static_cast<uint32_t>(ends.size());
+            ends.push_back({Min_(p.box, axis), MakeId_(proxy, false)});
+            p.maxIndex[axis] = static_cast<uint32_t>(ends.size());
+            ends.push_back({Max_(p.box, axis), MakeId_(proxy, true)});
+        }
+        proxyCount++;
+        return proxy;
+    }
+
+    /** @brief Remove a proxy. Its pairs are reported as ended by the next Update() */
+    inline void Remove(int32_t proxy)
+    {
+        CheckProxy_(proxy);
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            // Erase the max first, so the min index stays valid
+            EraseEndpoint_(axis, proxies[proxy].maxIndex[axis]);
+            EraseEndpoint_(axis, proxies[proxy].minIndex[axis]);
+        }
+
+        for (auto it = pairs.begin(); it != pairs.end();)
+        {
+            if (PairA_(*it) == proxy || PairB_(*it) == proxy)
+            {
+                removedEnded.push_back(*it);
+                it = pairs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        proxies[proxy].alive = false;
+        proxies[proxy].data = Data{};
+        freeList.push_back(proxy);
+        proxyCount--;
+    }
+
+    /** @brief Set the box of a proxy. Pairs are updated at the next Update() */
+    inline void Move(int32_t proxy, const AABB &box)
+    {
+        CheckProxy_(proxy);
+        Proxy &p = proxies[proxy];
+        p.box = AABBBounds::From(box);
+        for (int axis = 0; axis < 2; axis++)
+        {
+            axes[axis][p.minIndex[axis]].value = Min_(p.box, axis);
+            axes[axis][p.maxIndex[axis]].value = Max_(p.box, axis);
+        }
+    }
+
+    /**
+     * @brief Re-sort both axes and update the pair set. Afterwards, GetBegan()
+     * and GetEnded() hold the pairs whose overlap changed since the last call.
+     */
+    inline void Update()
+    {
+        began.clear();
+        ended.clear();
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            Sort_(axis);
+        }
+
+        // A pair can start and stop overlapping within one update (e.g. on
+        // different axes); report only the net change
+        std::sort(began.begin(), began.end());
+        std::sort(ended.begin(), ended.end());
+        netBegan.clear();
+        std::set_difference(began.begin(), began.end(), ended.begin(), ended.end(), std::back_inserter(netBegan));
+        netEnded.clear();
+        std::set_difference(ended.begin(), ended.end(), began.begin(), began.end(), std::back_inserter(netEnded));
+        netEnded.insert(netEnded.end(), removedEnded.begin(), removedEnded.end());
+        removedEnded.clear();
+
+        beganPairs.clear();
+        for (uint64_t key : netBegan)
+        {
+            beganPairs.push_back({PairA_(key), PairB_(key)});
+        }
+        endedPairs.clear();
+        for (uint64_t key : netEnded)
+        {
+            endedPairs.push_back({PairA_(key), PairB_(key)});
+        }
+    }
+
+    /** @brief Pairs that started overlapping during the last Update(), lower proxy first */
+    inline const std::vector<Pair> &GetBegan() const
+    {
+        return beganPairs;
+    }
+
+    /** @brief Pairs that stopped overlapping during the last Update(), or lost a proxy before it */
+    inline const std::vector<Pair> &GetEnded() const
+    {
+        return endedPairs;
+    }
+
+    /** @brief Call `fn(a, b)` for every pair currently overlapping, as of the last Update() */
+    template <typename Fn>
+    inline void ForEachPair(Fn &&fn) const
+    {
+        for (uint64_t key : pairs)
+        {
+            fn(PairA_(key), PairB_(key));
+        }
+    }
+
+    inline bool HasPair(int32_t a, int32_t b) const
+    {
+        return pairs.count(MakeKey_(a, b)) != 0;
+    }
+
+    inline size_t PairCount() const
+    {
+        return pairs.size();
+    }
+
+    inline Data &GetData(int32_t proxy)
+    {
+        CheckProxy_(proxy);
+        return proxies[proxy].data;
+    }
+
+    inline AABB GetAABB(int32_t proxy) const
+    {
+        CheckProxy_(proxy);
+        return proxies[proxy].box.ToAABB();
+    }
+
+    /** @brief Number of proxies */
+    inline size_t Size() const
+    {
+        return proxyCount;
+    }
+
+    /** @brief Number of endpoint swaps made by the last Update(); a measure of how incoherent the motion was */
+    inline size_t LastSwapCount() const
+    {
+        return swapCount;
+    }
+
+private:
+    struct Endpoint
+    {
+        double value;
+        /** @brief Proxy id shifted left by one, with the low bit set for max endpoints */
+        uint32_t id;
+
+        inline int32_t GetProxy() const
+        {
+            return static_cast<int32_t>(id >> 1);
+        }
+
+        inline bool IsMax() const
+        {
+            return id & 1;
+        }
+
+        /** @brief Mins sort before maxes at equal values, so touching boxes overlap like in CheckCollision */
+        inline bool operator<(const Endpoint &other) const
+        {
+            return value < other.value || (value == other.value && !IsMax() && other.IsMax());
+        }
+    };
+
+    struct Proxy
+    {
+        AABBBounds box{};
+        Data data{};
+        uint32_t minIndex[2] = {0, 0};
+        uint32_t maxIndex[2] = {0, 0};
+        bool alive = false;
+    };
+
+    inline static uint32_t MakeId_(int32_t proxy, bool isMax)
+    {
+        return (static_cast<uint32_t>(proxy) << 1) | (isMax ? 1 : 0);
+    }
+
+    inline static uint64_t MakeKey_(int32_t a, int32_t b)
+    {
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+        return (static_cast<uint64_t>(a) << 32) | static_cast<uint32_t>(b);
+    }
+
+    inline static int32_t PairA_(uint64_t key)
+    {
+        return static_cast<int32_t>(key >> 32);
+    }
+
+    inline static int32_t PairB_(uint64_t key)
+    {
+        return static_cast<int32_t>(key & UINT32_MAX);
+    }
+
+    inline static double Min_(const AABBBounds &box, int axis)
+    {
+        return axis == 0 ? box.minX : box.minY;
+    }
+
+    inline static double Max_(const AABBBounds &box, int axis)
+    {
+        return axis == 0 ? box.maxX : box.maxY;
+    }
+
+    inline void SetIndex_(const Endpoint &end, int axis, uint32_t index)
+    {
+        Proxy &p = proxies[end.GetProxy()];
+        (end.IsMax() ? p.maxIndex : p.minIndex)[axis] = index;
+    }
+
+    /** @brief Insertion sort of one axis, turning min/max swaps into pair changes */
+    inline void Sort_(int axis)
+    {
+        std::vector<Endpoint> &ends = axes[axis];
+        if (axis == 0)
+        {
+            swapCount = 0;
+        }
+
+        for (size_t i = 1; i < ends.size(); i++)
+        {
+            Endpoint end = ends[i];
+            size_t j = i;
+            while (j > 0 && end < ends[j - 1])
+            {
+                const Endpoint &prev = ends[j - 1];
+                if (!end.IsMax() && prev.IsMax())
+                {
+                    // A min moved below another box's max: they now overlap on this axis
+                    if (proxies[end.GetProxy()].box.Overlaps(proxies[prev.GetProxy()].box))
+                    {
+                        AddPair_(end.GetProxy(), prev.GetProxy());
+                    }
+                }
+                else if (end.IsMax() && !prev.IsMax())
+                {
+                    // A max moved below another box's min: they no longer overlap
+                    RemovePair_(end.GetProxy(), prev.GetProxy());
+                }
+
+                ends[j] = prev;
+                SetIndex_(ends[j], axis, static_cast<uint32_t>(j));
+                j--;
+                swapCount++;
+            }
+            if (j != i)
+            {
+                ends[j] = end;
+                SetIndex_(end, axis, static_cast<uint32_t>(j));
+            }
+        }
+    }
+
+    inline void AddPair_(int32_t a, int32_t b)
+    {
+        if (a != b && pairs.insert(MakeKey_(a, b)).second)
+        {
+            began.push_back(MakeKey_(a, b));
+        }
+    }
+
+    inline void RemovePair_(int32_t a, int32_t b)
+    {
+        if (a != b && pairs.erase(MakeKey_(a, b)) != 0)
+        {
+            ended.push_back(MakeKey_(a, b));
+        }
+    }
+
+    inline void EraseEndpoint_(int axis, uint32_t index)
+    {
+        std::vector<Endpoint> &ends = axes[axis];
+        ends.erase(ends.begin() + index);
+        for (size_t i = index; i < ends.size(); i++)
+        {
+            SetIndex_(ends[i], axis, static_cast<uint32_t>(i));
+        }
+    }
+
+    inline void CheckProxy_(int32_t proxy) const
+    {
+        if (proxy < 0 || static_cast<size_t>(proxy) >= proxies.size() || !proxies[proxy].alive)
+        {
+            throw std::runtime_error("Invalid sweep-and-prune proxy");
+        }
+    }
+
+    std::vector<Proxy> proxies;
+    std::vector<int32_t> freeList;
+    size_t proxyCount = 0;
+
+    /** @brief Endpoints along x (0) and y (1), sorted as of the last Update() */
+    std::vector<Endpoint> axes[2];
+
+    std::unordered_set<uint64_t> pairs;
+    size_t swapCount = 0;
+
+    // Raw pair changes of the current Update(), and pairs lost to Remove() since the last one
+    std::vector<uint64_t> began;
+    std::vector<uint64_t> ended;
+    std::vector<uint64_t> removedEnded;
+    std::vector<uint64_t> netBegan;
+    std::vector<uint64_t> netEnded;
+
+    std::vector<Pair> beganPairs;
+    std::vector<Pair> endedPairs;
+};
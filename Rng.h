@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+//------------------------------------------------------------------------------
+// Rng definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief xoshiro256** pseudo-random generator.
+ * - Small (32 bytes of state), lock-free and several times faster than rand()
+ * - Fully specified: the same seed yields the same sequence on every platform
+ *   and standard library, so seeded simulations replay bit-for-bit
+ * - Satisfies UniformRandomBitGenerator, so it also works with <random>
+ *   distributions (whose output is *not* portable, unlike Uniform/Fill)
+ */
+class Rng
+{
+public:
+    using result_type = uint64_t;
+
+    explicit Rng(uint64_t seed = 1)
+    {
+        Seed(seed);
+    }
+
+    /** @brief Reset the state from a 64-bit seed. Nearby seeds give unrelated streams */
+    inline void Seed(uint64_t seed)
+    {
+        // Expand the seed with splitmix64, as recommended for xoshiro
+        for (uint64_t &word : state)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    inline static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    inline static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    inline result_type operator()()
+    {
+        return Next();
+    }
+
+    inline uint64_t Next()
+    {
+        const uint64_t result = Rotl_(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = Rotl_(state[3], 45);
+
+        return result;
+    }
+
+    /** @brief Uniform double in [0, 1), using the top 53 bits */
+    inline double NextDouble()
+    {
+        return (Next() >> 11) * 0x1.0p-53;
+    }
+
+    /** @brief Uniform double in [lo, hi), or exactly lo if the range is empty */
+    inline double Uniform(double lo, double hi)
+    {
+        return ToRange(NextDouble(), lo, hi);
+    }
+
+    /**
+     * @brief Fill `out` with uniform doubles in [lo, hi). Produces exactly the
+     * values that the same number of Uniform(lo, hi) calls would.
+     */
+    inline void Fill(std::span<double> out, double lo, double hi)
+    {
+        // Work on a local copy so the state stays in registers across the loop
+        Rng local = *this;
+        for (double &value : out)
+        {
+            value = ToRange(local.NextDouble(), lo, hi);
+        }
+        *this = local;
+    }
+
+    /**
+     * @brief Map `unit` in [0, 1) to [lo, hi). `lo + unit * (hi - lo)` can
+     * round up to `hi`, so that case is pulled back to the largest double below it
+     */
+    inline static double ToRange(double unit, double lo, double hi)
+    {
+        double value = lo + unit * (hi - lo);
+        return value < hi || !(hi > lo) ? value : std::nextafter(hi, lo);
+    }
+
+    inline bool operator==(const Rng &other) const = default;
+
+private:
+    inline static uint64_t Rotl_(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state[4];
+};
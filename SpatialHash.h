@@ -0,0 +1,379 @@
+#pragma once
+
+#include "Game.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+/** @brief Default broadphase cell size, in world units */
+constexpr double DEFAULT_CELL_SIZE = 8;
+
+//------------------------------------------------------------------------------
+// Toroidal helpers
+//------------------------------------------------------------------------------
+
+constexpr bool WrapsX(WrapType wrap)
+{
+    return wrap == kWrapX || wrap == kWrapBoth;
+}
+
+constexpr bool WrapsY(WrapType wrap)
+{
+    return wrap == kWrapY || wrap == kWrapBoth;
+}
+
+/** @brief Fold `delta` into [-width / 2, width / 2] */
+inline double WrapDelta_(double delta, double width)
+{
+    // Fast path: both points are inside the world, so at most one step is needed
+    double half = width / 2;
+    if (delta >= -half && delta <= half)
+    {
+        return delta;
+    }
+    if (delta > half && delta - width >= -half)
+    {
+        return delta - width;
+    }
+    if (delta < -half && delta + width <= half)
+    {
+        return delta + width;
+    }
+    return std::remainder(delta, width);
+}
+
+/**
+ * @brief Shortest displacement from `from` to `to` in the current world. Along
+ * wrapped axes this may go across the seam, e.g. from just inside the right
+ * edge to just inside the left edge is a small positive step.
+ */
+template <WrapType Wrap>
+inline Vector2<Worldspace> WrappedOffset(const Vector2<Worldspace> &from, const Vector2<Worldspace> &to)
+{
+    double dx = (to.x() - from.x()).GetValue();
+    double dy = (to.y() - from.y()).GetValue();
+    if constexpr (WrapsX(Wrap))
+    {
+        dx = WrapDelta_(dx, XBounds::width());
+    }
+    if constexpr (WrapsY(Wrap))
+    {
+        dy = WrapDelta_(dy, YBounds::height());
+    }
+    return {dx, dy};
+}
+
+//------------------------------------------------------------------------------
+// SpatialHash definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Uniform-grid broadphase over world space, meant to be rebuilt every
+ * tick: Clear(), Insert() every collidable, then FindPairs() or Query().
+ * - Each entry is an axis-aligned box, registered in every cell it touches
+ * - Cells are kept in one flat array sorted by cell key, so building costs a
+ *   single sort, and no memory is allocated once the arrays have warmed up
+ * - Along wrapped axes the grid tiles the world exactly and cell indices wrap
+ *   around, so boxes straddling the seam land in cells on both sides and
+ *   overlap tests measure distance across it
+ * - Only box overlap is tested; results are candidates for an exact
+ *   narrowphase such as Entity::Collide
+ *
+ * The cell size should be around the diameter of a typical object. Bounds are
+ * read from the world bound to the calling thread when Clear() is called.
+ * Along unwrapped axes, boxes reaching past the world edge are clamped into
+ * the edge cells, and boxes with a NaN center or extent touch no cells.
+ */
+template <WrapType Wrap = kWrapNone>
+class SpatialHash
+{
+public:
+    using Pair = std::pair<Handle, Handle>;
+
+    explicit SpatialHash(Worldspace cellSize_ = Worldspace{DEFAULT_CELL_SIZE})
+        : cellSize{cellSize_.GetValue()}
+    {
+        if (!(cellSize > 0))
+        {
+            throw std::runtime_error("Cell size must be positive");
+        }
+        Clear();
+    }
+
+    /** @brief Remove every entry and pick up the bounds of the current world */
+    inline void Clear()
+    {
+        entries.clear();
+        cells.clear();
+        sorted = true;
+
+        x = MakeAxis_(XBounds::lowerBound, XBounds::width(), WrapsX(Wrap));
+        y = MakeAxis_(YBounds::lowerBound, YBounds::height(), WrapsY(Wrap));
+    }
+
+    /** @brief Add a box with the given center and half extents */
+    inline void Insert(Handle handle, const Vector2<Worldspace> &center, const Vector2<Worldspace> &halfExtents)
+    {
+        uint32_t index = static_cast<uint32_t>(entries.size());
+        Entry entry{handle, center.x().GetValue(), center.y().GetValue(),
+                    halfExtents.x().GetValue(), halfExtents.y().GetValue()};
+        entries.push_back(entry);
+
+        ForEachCell_(entry.cx, entry.cy, entry.hx, entry.hy, [this, index](uint64_t key)
+                     { cells.push_back({key, index}); });
+        sorted = false;
+    }
+
+    /** @brief Add the bounding box of a circle */
+    inline void Insert(Handle handle, const Vector2<Worldspace> &center, Worldspace radius)
+    {
+        Insert(handle, center, {radius, radius});
+    }
+
+    /**
+     * @brief Every pair of entries whose boxes overlap, each reported once with
+     * the earlier-inserted entry first. The result stays valid until the next
+     * Clear/Insert/FindPairs.
+     */
+    inline const std::vector<Pair> &FindPairs()
+    {
+        Sort_();
+
+        candidates.clear();
+        for (size_t begin = 0; begin < cells.size();)
+        {
+            size_t end = begin + 1;
+            while (end < cells.size() && cells[end].key == cells[begin].key)
+            {
+                end++;
+            }
+
+            for (size_t i = begin; i < end; i++)
+            {
+                for (size_t j = i + 1; j < end; j++)
+                {
+                    uint32_t a = cells[i].entry;
+                    uint32_t b = cells[j].entry;
+                    if (Overlaps_(entries[a], entries[b]))
+                    {
+                        // Entries appear in key order within a cell, so a < b
+                        candidates.push_back((static_cast<uint64_t>(a) << 32) | b);
+                    }
+                }
+            }
+            begin = end;
+        }
+
+        // Boxes sharing several cells are found once per shared cell
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        pairs.clear();
+        for (uint64_t candidate : candidates)
+        {
+            pairs.push_back({entries[candidate >> 32].handle, entries[candidate & UINT32_MAX].handle});
+        }
+        return pairs;
+    }
+
+    /** @brief Call `fn(handle)` once for every entry whose box overlaps the given box */
+    template <typename Fn>
+    inline void Query(const Vector2<Worldspace> &center, const Vector2<Worldspace> &halfExtents, Fn &&fn)
+    {
+        Sort_();
+
+        Entry probe{Handle{}, center.x().GetValue(), center.y().GetValue(),
+                    halfExtents.x().GetValue(), halfExtents.y().GetValue()};
+
+        // Stamp entries as they are reported, so boxes spanning several cells are reported once
+        if (++stamp == 0)
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            stamp = 1;
+        }
+        stamps.resize(entries.size(), 0);
+
+        ForEachCell_(probe.cx, probe.cy, probe.hx, probe.hy, [&](uint64_t key)
+                     {
+                         auto it = std::lower_bound(cells.begin(), cells.end(), key, [](const CellRef &cell, uint64_t k)
+                                                    { return cell.key < k; });
+                         for (; it != cells.end() && it->key == key; ++it)
+                         {
+                             const Entry &entry = entries[it->entry];
+                             if (stamps[it->entry] != stamp && Overlaps_(entry, probe))
+                             {
+                                 stamps[it->entry] = stamp;
+                                 fn(entry.handle);
+                             }
+                         } });
+    }
+
+    /** @brief Call `fn(handle)` once for every entry whose box contains `point` */
+    template <typename Fn>
+    inline void QueryPoint(const Vector2<Worldspace> &point, Fn &&fn)
+    {
+        Query(point, Vector2<Worldspace>{0, 0}, std::forward<Fn>(fn));
+    }
+
+    /** @brief Number of entries */
+    inline size_t Size() const
+    {
+        return entries.size();
+    }
+
+    inline Worldspace GetCellSize() const
+    {
+        return Worldspace{cellSize};
+    }
+
+private:
+    struct Entry
+    {
+        Handle handle;
+        double cx, cy;
+        double hx, hy;
+    };
+
+    struct CellRef
+    {
+        uint64_t key;
+        uint32_t entry;
+
+        inline bool operator<(const CellRef &other) const
+        {
+            return key != other.key ? key < other.key : entry < other.entry;
+        }
+    };
+
+    struct Axis
+    {
+        double lower;
+        double width;
+        double cell;
+        int64_t count;
+        bool wraps;
+    };
+
+    inline Axis MakeAxis_(double lower, double width, bool wraps) const
+    {
+        if (!(width > 0))
+        {
+            return {lower, width, cellSize, 1, false};
+        }
+        if (!wraps)
+        {
+            int64_t count = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(width / cellSize)));
+            return {lower, width, cellSize, count, false};
+        }
+
+        // Tile the world exactly, so cell indices agree on both sides of the seam
+        int64_t count = std::max<int64_t>(1, static_cast<int64_t>(width / cellSize));
+        return {lower, width, width / count, count, true};
+    }
+
+    /**
+     * @brief Call `fn(cellIndex)` for every cell [center - half, center + half]
+     * touches along `axis`. Indices are worked out in doubles and only cast once
+     * they are inside the grid, so huge or infinite input cannot overflow.
+     */
+    template <typename Fn>
+    inline static void ForEachAxisCell_(const Axis &axis, double center, double half, Fn &&fn)
+    {
+        double lo = std::floor((center - half - axis.lower) / axis.cell);
+        double hi = std::floor((center + half - axis.lower) / axis.cell);
+        if (!(lo <= hi))
+        {
+            // NaN, or a negative extent
+            return;
+        }
+
+        const double count = static_cast<double>(axis.count);
+        if (axis.wraps)
+        {
+            if (!(hi - lo + 1 < count))
+            {
+                // Covers the whole axis, or is unbounded
+                for (int64_t i = 0; i < axis.count; i++)
+                {
+                    fn(i);
+                }
+                return;
+            }
+
+            // fmod is exact, so far-away boxes land in the same cells as their wrapped copies
+            double first = std::fmod(lo, count);
+            if (first < 0)
+            {
+                first += count;
+            }
+            int64_t start = static_cast<int64_t>(first);
+            int64_t span = static_cast<int64_t>(hi - lo);
+            for (int64_t k = 0; k <= span; k++)
+            {
+                fn((start + k) % axis.count);
+            }
+        }
+        else
+        {
+            int64_t first = static_cast<int64_t>(std::clamp(lo, 0.0, count - 1));
+            int64_t last = static_cast<int64_t>(std::clamp(hi, 0.0, count - 1));
+            for (int64_t i = first; i <= last; i++)
+            {
+                fn(i);
+            }
+        }
+    }
+
+    template <typename Fn>
+    inline void ForEachCell_(double cx, double cy, double hx, double hy, Fn &&fn) const
+    {
+        ForEachAxisCell_(x, cx, hx, [&](int64_t ix)
+                         { ForEachAxisCell_(y, cy, hy, [&](int64_t iy)
+                                            { fn((static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) |
+                                                 static_cast<uint32_t>(iy)); }); });
+    }
+
+    inline bool Overlaps_(const Entry &a, const Entry &b) const
+    {
+        double dx = b.cx - a.cx;
+        double dy = b.cy - a.cy;
+        if (x.wraps)
+        {
+            dx = WrapDelta_(dx, x.width);
+        }
+        if (y.wraps)
+        {
+            dy = WrapDelta_(dy, y.width);
+        }
+        return std::abs(dx) <= a.hx + b.hx && std::abs(dy) <= a.hy + b.hy;
+    }
+
+    inline void Sort_()
+    {
+        if (!sorted)
+        {
+            std::sort(cells.begin(), cells.end());
+            sorted = true;
+        }
+    }
+
+    double cellSize;
+    Axis x;
+    Axis y;
+
+    std::vector<Entry> entries;
+    std::vector<CellRef> cells;
+    bool sorted = true;
+
+    // Scratch buffers, kept to avoid reallocating every tick
+    std::vector<uint64_t> candidates;
+    std::vector<Pair> pairs;
+    std::vector<uint32_t> stamps;
+    uint32_t stamp = 0;
+};
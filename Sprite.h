@@ -0,0 +1,162 @@
+#pragma once
+
+#include "AsciiGraphics.h"
+#include "Game.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Consts
+//------------------------------------------------------------------------------
+
+/** @brief Circle sprites are rasterized once per multiple of this radius */
+constexpr double SPRITE_RADIUS_STEP = 0.25;
+/** @brief Larger circles are drawn at this radius; it already covers the largest AsciiGraphics buffer */
+constexpr double SPRITE_MAX_RADIUS = MAX_WIDTH;
+
+//------------------------------------------------------------------------------
+// Sprite definition
+//------------------------------------------------------------------------------
+
+/** @brief A run of `length` cells starting `dx` cells right and `dy` cells down from a sprite's center */
+struct SpriteSpan
+{
+    int dx;
+    int dy;
+    uint length;
+};
+
+/** @brief A rasterized glyph mask, stored as horizontal spans so drawing it is a few run fills */
+struct Sprite
+{
+    std::vector<SpriteSpan> spans;
+    /** @brief Number of cells covered */
+    size_t cells = 0;
+
+    /** @brief Disc of the cells whose offset from the center cell is within `radius` */
+    inline static Sprite Circle(double radius)
+    {
+        Sprite sprite;
+        if (!(radius >= 0))
+        {
+            return sprite;
+        }
+
+        const double r2 = radius * radius;
+        const int extent = static_cast<int>(std::floor(radius));
+        for (int dy = -extent; dy <= extent; dy++)
+        {
+            // Widest half-width inside the circle, nudged to undo sqrt rounding
+            int half = static_cast<int>(std::floor(std::sqrt(r2 - dy * dy)));
+            while (half > 0 && half * half + dy * dy > r2)
+            {
+                half--;
+            }
+            while ((half + 1) * (half + 1) + dy * dy <= r2)
+            {
+                half++;
+            }
+
+            uint length = static_cast<uint>(2 * half + 1);
+            sprite.spans.push_back({-half, dy, length});
+            sprite.cells += length;
+        }
+        return sprite;
+    }
+};
+
+//------------------------------------------------------------------------------
+// SpriteCache definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Circle sprites keyed by radius quantized to SPRITE_RADIUS_STEP,
+ * rasterized on first use. The cache is per thread, so worlds running in
+ * parallel never contend for it. Sprites are never freed or moved, so the
+ * returned references stay valid.
+ *
+ * Radii are capped at SPRITE_MAX_RADIUS; non-finite radii give an empty sprite.
+ */
+class SpriteCache
+{
+public:
+    inline static const Sprite &Circle(double radius)
+    {
+        if (!std::isfinite(radius))
+        {
+            return empty;
+        }
+        radius = std::min(radius, SPRITE_MAX_RADIUS);
+        size_t key = radius > 0 ? static_cast<size_t>(std::lround(radius / SPRITE_RADIUS_STEP)) : 0;
+        if (key >= circles.size())
+        {
+            circles.resize(key + 1);
+        }
+        if (!circles[key])
+        {
+            circles[key] = std::make_unique<Sprite>(Sprite::Circle(key * SPRITE_RADIUS_STEP));
+        }
+        return *circles[key];
+    }
+
+private:
+    inline static thread_local std::vector<std::unique_ptr<Sprite>> circles;
+    inline static const Sprite empty{};
+};
+
+//------------------------------------------------------------------------------
+// Stamps
+//------------------------------------------------------------------------------
+
+/** @brief A sprite placed in the world, drawn with one glyph */
+template <WrapType Wrap>
+struct Stamp
+{
+    WorldX<Wrap> x;
+    WorldY<Wrap> y;
+    const Sprite *sprite;
+    char fill;
+};
+
+/**
+ * @brief Draw `sprite` centered on the cell at x, y. Along wrapped axes the
+ * sprite wraps like the world does: rows wrap individually, and spans crossing
+ * the seam are split and drawn on both sides.
+ */
+template <WrapType Wrap>
+inline void DrawSprite(AsciiGraphics &ascii, const Sprite &sprite, WorldX<Wrap> x, WorldY<Wrap> y, char fill)
+{
+    constexpr bool wrapsX = Wrap == kWrapX || Wrap == kWrapBoth;
+    for (const SpriteSpan &span : sprite.spans)
+    {
+        double row = static_cast<double>((y + Worldspace{static_cast<double>(span.dy)}).GetValue());
+        if (row < 0)
+        {
+            continue;
+        }
+        for (uint done = 0; done < span.length;)
+        {
+            double start = static_cast<double>((x + Worldspace{static_cast<double>(span.dx + static_cast<int>(done))}).GetValue());
+            uint run = span.length - done;
+            if (start < 0)
+            {
+                // Only possible on unwrapped axes: clip the part left of the screen
+                done += std::min(run, static_cast<uint>(std::ceil(-start)));
+                continue;
+            }
+            if constexpr (wrapsX)
+            {
+                run = std::min(run, std::max(1u, static_cast<uint>(std::ceil(XBounds::upperBound - start))));
+            }
+            ascii.DrawSpan(static_cast<uint>(start), static_cast<uint>(row), run, fill);
+            done += run;
+        }
+    }
+}
+
+template <WrapType Wrap>
+inline void DrawStamp(AsciiGraphics &ascii, const Stamp<Wrap> &stamp)
+{
+    DrawSprite<Wrap>(ascii, *stamp.sprite, stamp.x, stamp.y, stamp.fill);
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// ThreadPool definition
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-size work-stealing thread pool.
+ * - Every worker owns a deque. Tasks submitted from inside a task go to the
+ *   submitting worker's own deque, others are spread round-robin
+ * - A worker pops its own deque from the back (most recent, cache-warm work)
+ *   and, when that is empty, steals from the front of the other deques, so
+ *   uneven tasks still keep every core busy
+ * - Idle workers sleep on a condition variable rather than spinning
+ *
+ * Tasks must not throw, except under ParallelFor, which forwards the first
+ * exception to its caller.
+ */
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t numThreads = DefaultThreads())
+    {
+        numThreads = std::max<size_t>(numThreads, 1);
+        queues.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        threads.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads.emplace_back([this, i]()
+                                 { WorkerLoop_(i); });
+        }
+    }
+
+    /** @brief Finishes every queued task, then joins the workers */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{sleepMutex};
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    inline static size_t DefaultThreads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    inline size_t Size() const
+    {
+        return threads.size();
+    }
+
+    /** @brief Queue a task to run on some worker */
+    inline void Submit(Task task)
+    {
+        size_t index = currentPool == this ? currentWorker : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // Count the task before it becomes visible, so a worker popping it straight away never takes the count below zero
+        {
+            std::lock_guard<std::mutex> lock{sleepMutex};
+            queued++;
+        }
+        {
+            std::lock_guard<std::mutex> lock{queues[index]->mutex};
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Run `fn(i)` for every i in [0, n) across the pool and block until
+     * all of them are done. The calling thread runs queued tasks while it waits.
+     * If any call throws, the first exception is rethrown here once all calls
+     * have finished.
+     */
+    template <typename Fn>
+    inline void ParallelFor(size_t n, Fn &&fn)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+
+        struct Group
+        {
+            std::atomic<size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        } group;
+        group.remaining = n;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            Submit([&group, &fn, i]()
+                   {
+                       std::exception_ptr error;
+                       try
+                       {
+                           fn(i);
+                       }
+                       catch (...)
+                       {
+                           error = std::current_exception();
+                       }
+
+                       // Finish under the lock: the caller may destroy the group as soon as it sees zero
+                       std::lock_guard<std::mutex> lock{group.mutex};
+                       if (error && !group.error)
+                       {
+                           group.error = error;
+                       }
+                       if (group.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                       {
+                           group.done.notify_all();
+                       } });
+        }
+
+        // Help out instead of blocking straight away
+        Task task;
+        while (group.remaining.load(std::memory_order_acquire) > 0 && TryPop_(StartQueue_(), task))
+        {
+            task();
+            task = nullptr;
+        }
+
+        std::unique_lock<std::mutex> lock{group.mutex};
+        group.done.wait(lock, [&group]()
+                        { return group.remaining.load(std::memory_order_acquire) == 0; });
+        if (group.error)
+        {
+            std::rethrow_exception(group.error);
+        }
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /** @brief Queue a thread looks at first: its own for workers, any other for outside threads */
+    inline size_t StartQueue_() const
+    {
+        return currentPool == this ? currentWorker : nextQueue.load(std::memory_order_relaxed) % queues.size();
+    }
+
+    /** @brief Pop from the back of queue `self`, else steal from the front of the others */
+    inline bool TryPop_(size_t self, Task &task)
+    {
+        const size_t n = queues.size();
+        for (size_t k = 0; k < n; k++)
+        {
+            Queue &queue = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+            if (k == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    inline void WorkerLoop_(size_t index)
+    {
+        currentPool = this;
+        currentWorker = index;
+
+        Task task;
+        while (true)
+        {
+            if (TryPop_(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{sleepMutex};
+            wake.wait(lock, [this]()
+                      { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nextQueue{0};
+
+    // Queued-but-not-started tasks. Incremented under sleepMutex so sleeping workers never miss a wakeup
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    inline static thread_local ThreadPool *currentPool = nullptr;
+    inline static thread_local size_t currentWorker = 0;
+};
@@ -7,6 +7,8 @@
 #pragma once
 #include "Vector.h"
 #include <array>
+#include <stdexcept>
+#include <utility>
 
 /**
  * @brief Base class for an `M` row by `N` column matrix holding values of type `Type`
@@ -340,7 +342,7 @@ public:
     }
 
 private:
-    Array2D<Type, M, N> _v;
+    alignas((M == 4 && N == 4) ? SimdAlignment<4, Type>() : alignof(Type)) Array2D<Type, M, N> _v;
 };
 
 // Some aliases
@@ -417,6 +419,14 @@ template <typename LHS_MatType, size_t M, size_t N, typename RHS_VecType>
 inline Vector<M, MultiplyType<LHS_MatType, RHS_VecType>> operator*(const Matrix<M, N, LHS_MatType> &lhs_m, const Vector<N, RHS_VecType> &rhs_v)
     requires(HasDotProduct<LHS_MatType, RHS_VecType>)
 {
+    using ResType = MultiplyType<LHS_MatType, RHS_VecType>;
+    if constexpr (M == 4 && N == 4 && SimdCompatible<LHS_MatType, RHS_VecType, ResType>)
+    {
+        Vector<M, ResType> res;
+        SimdMatVec4(SimdPtr(&lhs_m.At(0, 0)), SimdPtr(&rhs_v[0]), SimdPtr(&res[0]));
+        return res;
+    }
+
     auto getComponent = [&](size_t i) -> MultiplyType<LHS_MatType, RHS_VecType>
     {
         return ([&]<size_t... Idxs>(std::index_sequence<Idxs...>) constexpr
@@ -438,6 +448,14 @@ template <typename LHS_MatType, size_t M, size_t N, typename RHS_MatType, size_t
 inline Matrix<M, P, MultiplyType<LHS_MatType, RHS_MatType>> operator*(const Matrix<M, N, LHS_MatType> &lhs_m, const Matrix<N, P, RHS_MatType> &rhs_m)
     requires(HasDotProduct<LHS_MatType, RHS_MatType>)
 {
+    using ResType = MultiplyType<LHS_MatType, RHS_MatType>;
+    if constexpr (M == 4 && N == 4 && P == 4 && SimdCompatible<LHS_MatType, RHS_MatType, ResType>)
+    {
+        Matrix<M, P, ResType> res;
+        SimdMatMul4(SimdPtr(&lhs_m.At(0, 0)), SimdPtr(&rhs_m.At(0, 0)), SimdPtr(&res.At(0, 0)));
+        return res;
+    }
+
     auto getCell = [&](size_t Row, size_t Col) constexpr -> MultiplyType<LHS_MatType, RHS_MatType>
     {
         return ([&]<size_t... Idxs>(std::index_sequence<Idxs...>)
@@ -452,6 +470,224 @@ inline Matrix<M, P, MultiplyType<LHS_MatType, RHS_MatType>> operator*(const Matr
               }; })(std::make_index_sequence<M * P>{});
 }
 
+//--------------------------------------------------------------------------------
+// LU decomposition
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Square matrices at least this large compute `Det` and `Inv` through LU
+ * decomposition rather than cofactor expansion, whose cost (and number of
+ * template instantiations) grows factorially with size. Below this size the
+ * fully unrolled expansion is still faster than the pivoting loop.
+ */
+constexpr size_t LU_MIN_SIZE = 6;
+
+/** @brief Floating-point scalars, plain or wrapped (e.g. `Unit<double>`) */
+template <typename T>
+concept LUScalar_ = std::floating_point<T> ||
+                    ((!IsContainer<T>) && requires { typename T::type; } && std::floating_point<typename T::type>);
+
+/**
+ * @brief Check that a matrix of `T` can be LU-decomposed: pivots can be compared
+ * by magnitude, and eliminating a row with the dimensionless factor `a / a`
+ * keeps the type of its entries.
+ */
+template <typename T>
+concept CanLUDecompose = LUScalar_<T> && Negatable<T> && requires(T a) {
+    { T{0} };
+    { a < a } -> std::convertible_to<bool>;
+    { a - (a / a) * a } -> ConvertibleOrConstructibleTo<T>;
+};
+
+/** @brief Check that `A x = b` can be solved for `x` (of type `RHS / T`) given an LU-decomposed `A` */
+template <typename T, typename RHS>
+concept CanLUSolve = CanLUDecompose<T> &&
+                     requires(T a, RHS b, DivideType<T, T> f, DivideType<RHS, T> x) {
+                         { b - f * b } -> ConvertibleOrConstructibleTo<RHS>;
+                         { b - a * x } -> ConvertibleOrConstructibleTo<RHS>;
+                         { b / a } -> ConvertibleOrConstructibleTo<DivideType<RHS, T>>;
+                     };
+
+/**
+ * @brief Result of `LUDecompose`: `P * A = L * U`, where `L` is unit lower
+ * triangular with dimensionless entries and `U` is upper triangular with the
+ * same type as `A`.
+ */
+template <size_t N, typename Type>
+struct LUDecomposition
+{
+    Matrix<N, N, DivideType<Type, Type>> lower{};
+    Matrix<N, N, Type> upper{};
+    /** @brief Row `i` of `L * U` is row `perm[i]` of `A` */
+    std::array<size_t, N> perm{};
+    bool oddPermutation = false;
+    bool singular = false;
+};
+
+template <typename Type>
+inline Type LUAbs_(const Type &val)
+{
+    return (val < Type{0}) ? ConvertOrConstruct<Type>(-1 * val) : val;
+}
+
+/**
+ * @brief Decompose a square matrix with Gaussian elimination and partial pivoting.
+ * If a zero pivot is found the result is flagged `singular` and left incomplete.
+ */
+template <typename Type, size_t N>
+    requires CanLUDecompose<Type>
+inline LUDecomposition<N, Type> LUDecompose(const Matrix<N, N, Type> &mat)
+{
+    using Factor = DivideType<Type, Type>;
+
+    LUDecomposition<N, Type> res;
+    res.upper = mat;
+    for (size_t i = 0; i < N; i++)
+    {
+        res.perm[i] = i;
+        res.lower.At(i, i) = ConvertOrConstruct<Factor>(1);
+    }
+
+    for (size_t k = 0; k < N; k++)
+    {
+        // Pick the largest remaining entry in this column as the pivot
+        size_t pivot = k;
+        Type best = LUAbs_(res.upper.At(k, k));
+        for (size_t r = k + 1; r < N; r++)
+        {
+            Type candidate = LUAbs_(res.upper.At(r, k));
+            if (best < candidate)
+            {
+                pivot = r;
+                best = candidate;
+            }
+        }
+
+        if (best == Type{0})
+        {
+            res.singular = true;
+            return res;
+        }
+
+        if (pivot != k)
+        {
+            std::swap(res.upper[k], res.upper[pivot]);
+            for (size_t c = 0; c < k; c++)
+            {
+                std::swap(res.lower.At(k, c), res.lower.At(pivot, c));
+            }
+            std::swap(res.perm[k], res.perm[pivot]);
+            res.oddPermutation = !res.oddPermutation;
+        }
+
+        for (size_t r = k + 1; r < N; r++)
+        {
+            Factor f = res.upper.At(r, k) / res.upper.At(k, k);
+            res.lower.At(r, k) = f;
+            res.upper.At(r, k) = Type{0};
+            for (size_t c = k + 1; c < N; c++)
+            {
+                res.upper.At(r, c) = ConvertOrConstruct<Type>(res.upper.At(r, c) - f * res.upper.At(k, c));
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Solve `A x = b` for `x` using a decomposition of `A`, without forming
+ * the inverse. Throws if `A` is singular.
+ */
+template <typename Type, size_t N, typename RHS_Type>
+    requires CanLUSolve<Type, RHS_Type>
+inline Vector<N, DivideType<RHS_Type, Type>> Solve(const LUDecomposition<N, Type> &lu, const Vector<N, RHS_Type> &b)
+{
+    if (lu.singular)
+    {
+        throw std::runtime_error("Cannot solve a singular system");
+    }
+
+    using ResType = DivideType<RHS_Type, Type>;
+
+    // Forward substitution: L y = P b
+    Vector<N, RHS_Type> y;
+    for (size_t i = 0; i < N; i++)
+    {
+        RHS_Type acc = b[lu.perm[i]];
+        for (size_t j = 0; j < i; j++)
+        {
+            acc = ConvertOrConstruct<RHS_Type>(acc - lu.lower.At(i, j) * y[j]);
+        }
+        y[i] = acc;
+    }
+
+    // Back substitution: U x = y
+    Vector<N, ResType> x;
+    for (size_t i = N; i-- > 0;)
+    {
+        RHS_Type acc = y[i];
+        for (size_t j = i + 1; j < N; j++)
+        {
+            acc = ConvertOrConstruct<RHS_Type>(acc - lu.upper.At(i, j) * x[j]);
+        }
+        x[i] = ConvertOrConstruct<ResType>(acc / lu.upper.At(i, i));
+    }
+    return x;
+}
+
+/** @brief Solve `A x = b` for `x` via LU decomposition. Throws if `A` is singular */
+template <typename Type, size_t N, typename RHS_Type>
+    requires CanLUSolve<Type, RHS_Type>
+inline Vector<N, DivideType<RHS_Type, Type>> Solve(const Matrix<N, N, Type> &mat, const Vector<N, RHS_Type> &b)
+{
+    return Solve(LUDecompose(mat), b);
+}
+
+/** @brief Determinant as the signed product of the pivots */
+template <typename Type, size_t N>
+    requires CanLUDecompose<Type> && CanExp<N, Type>
+inline ExpType<N, Type> LUDet_(const Matrix<N, N, Type> &mat)
+{
+    LUDecomposition<N, Type> lu = LUDecompose(mat);
+    if (lu.singular)
+    {
+        return ExpType<N, Type>{0};
+    }
+
+    ExpType<N, Type> det = ([&]<size_t... Is>(std::index_sequence<Is...>)
+                            {
+                                return ConvertOrConstruct<ExpType<N, Type>>((... * lu.upper.At(Is, Is))); //
+                            })(std::make_index_sequence<N>{});
+    return lu.oddPermutation ? ConvertOrConstruct<ExpType<N, Type>>(-1 * det) : det;
+}
+
+/** @brief Inverse built column by column from LU solves against the identity */
+template <typename Type, size_t N>
+    requires CanLUSolve<Type, DivideType<Type, Type>>
+inline Matrix<N, N, InvertType<Type>> LUInv_(const Matrix<N, N, Type> &mat)
+{
+    using Factor = DivideType<Type, Type>;
+
+    Matrix<N, N, InvertType<Type>> res;
+    LUDecomposition<N, Type> lu = LUDecompose(mat);
+    if (lu.singular)
+    {
+        return res;
+    }
+
+    for (size_t col = 0; col < N; col++)
+    {
+        Vector<N, Factor> e;
+        e[col] = ConvertOrConstruct<Factor>(1);
+        Vector<N, InvertType<Type>> x = Solve(lu, e);
+        for (size_t row = 0; row < N; row++)
+        {
+            res.At(row, col) = x[row];
+        }
+    }
+    return res;
+}
+
 //--------------------------------------------------------------------------------
 // Determinant
 //--------------------------------------------------------------------------------
@@ -501,13 +737,21 @@ constexpr inline ExpType<IterSize, Type> _Det(const Matrix<N, N, Type> &mat, std
 }
 
 /**
- * @brief Compute the determinant of a square matrix via laplace expansion
+ * @brief Compute the determinant of a square matrix via laplace expansion, or
+ * LU decomposition for floating-point matrices of size `LU_MIN_SIZE` and up
  */
 template <typename Type, size_t N>
     requires HasCrossProduct<Type, Type> && CanExp<N, Type>
 inline ExpType<N, Type> Det(const Matrix<N, N, Type> &mat)
 {
-    return _Det<N>(mat, std::make_index_sequence<N>{}, std::make_index_sequence<N>{});
+    if constexpr (N >= LU_MIN_SIZE && CanLUDecompose<Type>)
+    {
+        return LUDet_(mat);
+    }
+    else
+    {
+        return _Det<N>(mat, std::make_index_sequence<N>{}, std::make_index_sequence<N>{});
+    }
 }
 
 //--------------------------------------------------------------------------------
@@ -531,7 +775,8 @@ constexpr inline ExpType<N - 1, Type> GetCofactor(const Matrix<N, N, Type> &mat)
 
 /**
  * @brief Compute the inverse of a matrix. If it is not invertbile, return
- * a default-constructed empty matrix.
+ * a default-constructed empty matrix. Floating-point matrices of size
+ * `LU_MIN_SIZE` and up are inverted through LU decomposition.
  */
 
 template <typename Type, size_t N>
@@ -547,26 +792,33 @@ template <typename Type, size_t N>
     }
 inline Matrix<N, N, InvertType<Type>> Inv(const Matrix<N, N, Type> &mat)
 {
-    // return Matrix<N, N, InvertType<Type>>{};
-    ExpType<N, Type> d = Det(mat);
-    if (d == ExpType<N, Type>{0})
+    if constexpr (N >= LU_MIN_SIZE && CanLUSolve<Type, DivideType<Type, Type>>)
     {
-        return Matrix<N, N, InvertType<Type>>{};
-    }
-    else if constexpr (N == 1)
-    {
-        return Matrix<N, N, InvertType<Type>>{(mat[0][0] / mat[0][0]) / mat[0][0]};
-    }
-    else if constexpr (N == 2)
-    {
-        return Matrix<N, N, InvertType<Type>>{mat[1][1] / d, (-1 * mat[0][1]) / d, (-1 * mat[1][0]) / d, mat[0][0] / d};
+        return LUInv_(mat);
     }
     else
     {
-        return ([&]<size_t... Idxs>(std::index_sequence<Idxs...>) constexpr
-                { return (Matrix<N, N, InvertType<Type>>{
-                      (GetCofactor<get_col<N, N>(Idxs), get_row<N, N>(Idxs)>(mat) / d)... //
-                  }); })(std::make_index_sequence<N * N>{});
+        // return Matrix<N, N, InvertType<Type>>{};
+        ExpType<N, Type> d = Det(mat);
+        if (d == ExpType<N, Type>{0})
+        {
+            return Matrix<N, N, InvertType<Type>>{};
+        }
+        else if constexpr (N == 1)
+        {
+            return Matrix<N, N, InvertType<Type>>{(mat[0][0] / mat[0][0]) / mat[0][0]};
+        }
+        else if constexpr (N == 2)
+        {
+            return Matrix<N, N, InvertType<Type>>{mat[1][1] / d, (-1 * mat[0][1]) / d, (-1 * mat[1][0]) / d, mat[0][0] / d};
+        }
+        else
+        {
+            return ([&]<size_t... Idxs>(std::index_sequence<Idxs...>) constexpr
+                    { return (Matrix<N, N, InvertType<Type>>{
+                          (GetCofactor<get_col<N, N>(Idxs), get_row<N, N>(Idxs)>(mat) / d)... //
+                      }); })(std::make_index_sequence<N * N>{});
+        }
     }
 }
 
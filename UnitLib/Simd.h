@@ -0,0 +1,320 @@
+//--------------------------------------------------------------------------------
+// SIMD helpers
+//
+//   Register-width kernels for 4-wide float/double vectors and 4x4 matrices.
+//   Vector and Matrix dispatch to these with `if constexpr` when their element
+//   types are plain floats/doubles or Units wrapping them, so the public API
+//   is unchanged and everything else keeps using the generic fold code.
+//--------------------------------------------------------------------------------
+
+#pragma once
+
+#include "TypeUtils.h"
+#include <type_traits>
+
+#if defined(__SSE__) || defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+//--------------------------------------------------------------------------------
+// Lane traits
+//--------------------------------------------------------------------------------
+
+/** @brief Check that SIMD kernels exist for scalar type `S` on this target */
+template <typename S>
+constexpr bool SimdEnabled()
+{
+#if defined(__SSE__)
+    if constexpr (std::is_same_v<S, float>)
+    {
+        return true;
+    }
+#endif
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<S, double>)
+    {
+        return true;
+    }
+#endif
+    return false;
+}
+
+template <typename T>
+struct SimdLane_
+{
+    static constexpr bool value = false;
+};
+
+template <typename T>
+    requires std::is_same_v<T, float> || std::is_same_v<T, double>
+struct SimdLane_<T>
+{
+    static constexpr bool value = true;
+    using scalar = T;
+};
+
+/**
+ * Units are recognized structurally (a non-container wrapper exposing `type`
+ * with exactly its layout) so that Vector does not need to include Unit.h
+ */
+template <typename T>
+    requires(!IsContainer<T>) &&
+            requires { typename T::type; } &&
+            (std::is_same_v<typename T::type, float> || std::is_same_v<typename T::type, double>) &&
+            std::is_standard_layout_v<T> && (sizeof(T) == sizeof(typename T::type))
+struct SimdLane_<T>
+{
+    static constexpr bool value = true;
+    using scalar = typename T::type;
+};
+
+/** @brief Element type whose storage is exactly one float or double */
+template <typename T>
+concept SimdLane = SimdLane_<T>::value;
+
+template <SimdLane T>
+using SimdScalar = typename SimdLane_<T>::scalar;
+
+/**
+ * @brief Check that all types are lanes over the same scalar, and that the
+ * target has kernels for it. Unit ratios live in the type, so the raw stored
+ * values can be combined directly.
+ */
+template <typename T, typename... Ts>
+concept SimdCompatible = SimdLane<T> && (SimdLane<Ts> && ...) &&
+                         (std::is_same_v<SimdScalar<T>, SimdScalar<Ts>> && ...) &&
+                         SimdEnabled<SimdScalar<T>>();
+
+/** @brief Storage alignment for `N` elements of `T`: a full register for 4-wide lanes */
+template <size_t N, typename T>
+constexpr size_t SimdAlignment()
+{
+    if constexpr (N == 4 && SimdLane<T>)
+    {
+        return 4 * sizeof(SimdScalar<T>);
+    }
+    else
+    {
+        return alignof(T);
+    }
+}
+
+template <SimdLane T>
+inline SimdScalar<T> *SimdPtr(T *ptr)
+{
+    return reinterpret_cast<SimdScalar<T> *>(ptr);
+}
+
+template <SimdLane T>
+inline const SimdScalar<T> *SimdPtr(const T *ptr)
+{
+    return reinterpret_cast<const SimdScalar<T> *>(ptr);
+}
+
+//--------------------------------------------------------------------------------
+// Kernels
+//
+//   Sums are accumulated in the same order as the generic folds and no FMA is
+//   used, so results are bitwise identical to the non-SIMD path.
+//--------------------------------------------------------------------------------
+
+#if defined(__SSE__)
+
+inline void SimdAdd4(const float *a, const float *b, float *out)
+{
+    _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+}
+
+inline void SimdSub4(const float *a, const float *b, float *out)
+{
+    _mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+}
+
+inline void SimdMul4(const float *a, const float *b, float *out)
+{
+    _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+}
+
+inline void SimdScale4(const float *a, float s, float *out)
+{
+    _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+}
+
+/** @brief out = m * v for a row-major 4x4 matrix */
+inline void SimdMatVec4(const float *m, const float *v, float *out)
+{
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+    _mm_storeu_ps(out, r);
+}
+
+/** @brief out = a * b for row-major 4x4 matrices. `out` may not alias `b` */
+inline void SimdMatMul4(const float *a, const float *b, float *out)
+{
+    __m128 b0 = _mm_loadu_ps(b);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 b2 = _mm_loadu_ps(b + 8);
+    __m128 b3 = _mm_loadu_ps(b + 12);
+    for (size_t i = 0; i < 4; i++)
+    {
+        const float *row = a + 4 * i;
+        __m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[1]), b1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), b2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[3]), b3));
+        _mm_storeu_ps(out + 4 * i, r);
+    }
+}
+
+#endif
+
+#if defined(__AVX__)
+
+inline void SimdAdd4(const double *a, const double *b, double *out)
+{
+    _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+}
+
+inline void SimdSub4(const double *a, const double *b, double *out)
+{
+    _mm256_storeu_pd(out, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+}
+
+inline void SimdMul4(const double *a, const double *b, double *out)
+{
+    _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+}
+
+inline void SimdScale4(const double *a, double s, double *out)
+{
+    _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+}
+
+/** @brief out = m * v for a row-major 4x4 matrix */
+inline void SimdMatVec4(const double *m, const double *v, double *out)
+{
+    __m256d r0 = _mm256_loadu_pd(m);
+    __m256d r1 = _mm256_loadu_pd(m + 4);
+    __m256d r2 = _mm256_loadu_pd(m + 8);
+    __m256d r3 = _mm256_loadu_pd(m + 12);
+
+    // Transpose rows into columns
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    __m256d c0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    __m256d c1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    __m256d c2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    __m256d c3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    __m256d r = _mm256_mul_pd(c0, _mm256_set1_pd(v[0]));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c1, _mm256_set1_pd(v[1])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c2, _mm256_set1_pd(v[2])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(c3, _mm256_set1_pd(v[3])));
+    _mm256_storeu_pd(out, r);
+}
+
+/** @brief out = a * b for row-major 4x4 matrices. `out` may not alias `b` */
+inline void SimdMatMul4(const double *a, const double *b, double *out)
+{
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + 4);
+    __m256d b2 = _mm256_loadu_pd(b + 8);
+    __m256d b3 = _mm256_loadu_pd(b + 12);
+    for (size_t i = 0; i < 4; i++)
+    {
+        const double *row = a + 4 * i;
+        __m256d r = _mm256_mul_pd(_mm256_set1_pd(row[0]), b0);
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(row[1]), b1));
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(row[2]), b2));
+        r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(row[3]), b3));
+        _mm256_storeu_pd(out + 4 * i, r);
+    }
+}
+
+#elif defined(__SSE2__)
+
+// Without AVX, each 4-wide double is handled as two SSE2 halves
+
+inline void SimdAdd4(const double *a, const double *b, double *out)
+{
+    _mm_storeu_pd(out, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(out + 2, _mm_add_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+}
+
+inline void SimdSub4(const double *a, const double *b, double *out)
+{
+    _mm_storeu_pd(out, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(out + 2, _mm_sub_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+}
+
+inline void SimdMul4(const double *a, const double *b, double *out)
+{
+    _mm_storeu_pd(out, _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    _mm_storeu_pd(out + 2, _mm_mul_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+}
+
+inline void SimdScale4(const double *a, double s, double *out)
+{
+    __m128d s2 = _mm_set1_pd(s);
+    _mm_storeu_pd(out, _mm_mul_pd(_mm_loadu_pd(a), s2));
+    _mm_storeu_pd(out + 2, _mm_mul_pd(_mm_loadu_pd(a + 2), s2));
+}
+
+/** @brief out = m * v for a row-major 4x4 matrix */
+inline void SimdMatVec4(const double *m, const double *v, double *out)
+{
+    // Rows (0,1) and (2,3) are computed as pairs; column k of a pair is {m[0][k], m[1][k]}
+    for (size_t half = 0; half < 2; half++)
+    {
+        const double *ra = m + 8 * half;
+        const double *rb = ra + 4;
+        __m128d lo_a = _mm_loadu_pd(ra), hi_a = _mm_loadu_pd(ra + 2);
+        __m128d lo_b = _mm_loadu_pd(rb), hi_b = _mm_loadu_pd(rb + 2);
+
+        __m128d r = _mm_mul_pd(_mm_unpacklo_pd(lo_a, lo_b), _mm_set1_pd(v[0]));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_unpackhi_pd(lo_a, lo_b), _mm_set1_pd(v[1])));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_unpacklo_pd(hi_a, hi_b), _mm_set1_pd(v[2])));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_unpackhi_pd(hi_a, hi_b), _mm_set1_pd(v[3])));
+        _mm_storeu_pd(out + 2 * half, r);
+    }
+}
+
+/** @brief out = a * b for row-major 4x4 matrices. `out` may not alias `b` */
+inline void SimdMatMul4(const double *a, const double *b, double *out)
+{
+    __m128d b0l = _mm_loadu_pd(b), b0h = _mm_loadu_pd(b + 2);
+    __m128d b1l = _mm_loadu_pd(b + 4), b1h = _mm_loadu_pd(b + 6);
+    __m128d b2l = _mm_loadu_pd(b + 8), b2h = _mm_loadu_pd(b + 10);
+    __m128d b3l = _mm_loadu_pd(b + 12), b3h = _mm_loadu_pd(b + 14);
+    for (size_t i = 0; i < 4; i++)
+    {
+        const double *row = a + 4 * i;
+        __m128d a0 = _mm_set1_pd(row[0]), a1 = _mm_set1_pd(row[1]);
+        __m128d a2 = _mm_set1_pd(row[2]), a3 = _mm_set1_pd(row[3]);
+
+        __m128d lo = _mm_mul_pd(a0, b0l);
+        lo = _mm_add_pd(lo, _mm_mul_pd(a1, b1l));
+        lo = _mm_add_pd(lo, _mm_mul_pd(a2, b2l));
+        lo = _mm_add_pd(lo, _mm_mul_pd(a3, b3l));
+
+        __m128d hi = _mm_mul_pd(a0, b0h);
+        hi = _mm_add_pd(hi, _mm_mul_pd(a1, b1h));
+        hi = _mm_add_pd(hi, _mm_mul_pd(a2, b2h));
+        hi = _mm_add_pd(hi, _mm_mul_pd(a3, b3h));
+
+        _mm_storeu_pd(out + 4 * i, lo);
+        _mm_storeu_pd(out + 4 * i + 2, hi);
+    }
+}
+
+#endif
@@ -7,7 +7,12 @@
 #include "Ratio.h"
 #include "StringLiteral.h"
 #include "TypeUtils.h"
+#include <array>
+#include <cstdint>
+#include <numeric>
 #include <string>
+#include <tuple>
+#include <utility>
 
 /**
  * UnitIdentifier - the unique representation of a particular unit. Comprised of atomic units and exponents
@@ -101,32 +106,6 @@ concept _CompareSymb = requires {
 template <typename A, typename B>
 concept ULCompare = IsUnitLeaf<A> && IsUnitLeaf<B> && _CompareSymb<A, B>;
 
-// Comparison selector SmallerOf
-template <typename A, typename B>
-    requires(IsUnitLeaf<A> && IsUnitLeaf<B>)
-struct ULSmallerOf_
-{
-};
-
-template <typename A, typename B>
-    requires(IsUnitLeaf<A> && IsUnitLeaf<B> && ULCompare<A, B>)
-struct ULSmallerOf_<A, B>
-{
-    using type = A;
-};
-
-template <typename A, typename B>
-    requires(IsUnitLeaf<A> && IsUnitLeaf<B> && !ULCompare<A, B>)
-struct ULSmallerOf_<A, B>
-{
-    using type = B;
-};
-
-template <typename A, typename B>
-    requires(IsUnitLeaf<A> && IsUnitLeaf<B>)
-using ULSmallerOf = typename ULSmallerOf_<A, B>::type;
-
-
 /** Combine two unitleaves (and add their exponents) */
 template <typename U, typename V>
     requires(IsUnitLeaf<U> && IsUnitLeaf<V>)
@@ -175,17 +154,6 @@ template <typename H, typename V>
     requires(IsUnitLeaf<H> && IsUnitLeafVector<V>)
 using ULAppend = typename ULAppendHelper<H, V>::type;
 
-/* popfront */
-template <typename T>
-    requires IsUnitLeafVector<T>
-struct ULPopFront;
-
-template <IsUnitLeaf H, IsUnitLeaf... T>
-struct ULPopFront<UnitLeafVector<H, T...>>
-{
-    using type = UnitLeafVector<T...>;
-};
-
 /** concat two lists */
 
 template <typename U, typename V>
@@ -202,36 +170,6 @@ template <typename U, typename V>
     requires(IsUnitLeafVector<U> && IsUnitLeafVector<V>)
 using ULConcat = typename ULConcat_<U, V>::type;
 
-/** Remove first occurrence of element R from Vector V */
-
-template <typename R, typename V>
-    requires(IsUnitLeaf<R> && IsUnitLeafVector<V>)
-struct ULRemoveFirst_;
-
-template <IsUnitLeaf R, IsUnitLeaf... T>
-struct ULRemoveFirst_<R, UnitLeafVector<R, T...>> // head is matching
-{
-    using type = UnitLeafVector<T...>;
-};
-
-template <IsUnitLeaf R, IsUnitLeaf H, IsUnitLeaf... T>
-struct ULRemoveFirst_<R, UnitLeafVector<H, T...>> // head is not matching
-{
-    using type = ULPrepend<H, typename ULRemoveFirst_<R, UnitLeafVector<T...>>::type>;
-};
-
-template <IsUnitLeaf R, IsUnitLeaf... T>
-    requires(sizeof...(T) == 0)
-struct ULRemoveFirst_<R, UnitLeafVector<T...>> // handle empty case
-{
-    using type = UnitLeafVector<T...>;
-};
-
-// alias
-template <typename R, typename V>
-    requires(IsUnitLeaf<R> && IsUnitLeafVector<V>)
-using ULRemoveFirst = typename ULRemoveFirst_<R, V>::type;
-
 /** Invert a UnitLeaf */
 template <IsUnitLeaf V>
 using ULInvert = UnitLeaf<V::symbol, std::ratio_multiply<typename V::exponent, std::ratio<-1>>>;
@@ -243,17 +181,10 @@ struct InvertUnitLeafVector_
 {
 };
 
-template <IsUnitLeaf H, IsUnitLeaf... T>
-struct InvertUnitLeafVector_<UnitLeafVector<H, T...>>
-{
-    using type = ULPrepend<ULInvert<H>, typename InvertUnitLeafVector_<UnitLeafVector<T...>>::type>;
-};
-
 template <IsUnitLeaf... T>
-    requires(sizeof...(T) == 0)
 struct InvertUnitLeafVector_<UnitLeafVector<T...>>
 {
-    using type = UnitLeafVector<T...>;
+    using type = UnitLeafVector<ULInvert<T>...>;
 };
 
 template <typename V>
@@ -272,151 +203,183 @@ struct ExpUnitLeafVector_
 {
 };
 
-template <IsUnitLeaf H, IsUnitLeaf... T, IsRatio Exp>
-struct ExpUnitLeafVector_<UnitLeafVector<H, T...>,  Exp>
-{
-    using type = ULPrepend<ULExp<H, Exp>, typename ExpUnitLeafVector_<UnitLeafVector<T...>, Exp>::type>;
-};
-
 template <IsUnitLeaf... T, IsRatio Exp>
-    requires(sizeof...(T) == 0)
 struct ExpUnitLeafVector_<UnitLeafVector<T...>, Exp>
 {
-    using type = UnitLeafVector<T...>;
+    using type = UnitLeafVector<ULExp<T, Exp>...>;
 };
 
 template <typename V, typename Exp>
     requires(IsUnitLeafVector<V> && IsRatio<Exp>)
 using ExpUnitLeafVector = typename ExpUnitLeafVector_<V, Exp>::type;
 
-/** Define min */
-template <typename R, typename V>
-    requires(IsUnitLeaf<R> && IsUnitLeafVector<V>)
-struct ULMinRecurse;
-
-template <IsUnitLeaf M, IsUnitLeaf H, IsUnitLeaf... T>
-struct ULMinRecurse<M, UnitLeafVector<H, T...>>
-{
-    using _Recur = ULMinRecurse<ULSmallerOf<M, H>, UnitLeafVector<T...>>;
-    using min = typename _Recur::min;
-};
-
-template <IsUnitLeaf M, IsUnitLeaf... T>
-struct ULMinRecurse<M, UnitLeafVector<T...>>
-{
-    using min = M;
-};
-
-template <typename V>
-    requires(IsUnitLeafVector<V>)
-struct ULMin_;
-
-template <IsUnitLeaf H, IsUnitLeaf... T>
-struct ULMin_<UnitLeafVector<H, T...>>
-{
-    using min = typename ULMinRecurse<H, UnitLeafVector<T...>>::min;
-};
-
-template <typename V>
-    requires(IsUnitLeafVector<V>)
-using ULMin = typename ULMin_<V>::min;
-
-/** Define sort */
+/**
+ * Canonicalization (sort, merge, remove zeros)
+ *
+ * Rather than sorting with recursive type metaprograms (which instantiate a new
+ * intermediate UnitLeafVector at every step), the symbols and exponents of a
+ * vector's leaves are copied into constexpr arrays, sorted and merged there
+ * with ordinary constexpr code, and then expanded back into a UnitLeafVector
+ * in a single pack expansion.
+ */
 
-template <typename Prefix, typename Rest>
-    requires(IsUnitLeafVector<Prefix> && IsUnitLeafVector<Rest>)
-struct ULSortRecurse;
+/** @brief Pick the `I`-th type of a pack, using the compiler builtin where there is one */
+#ifdef __has_builtin
+#if __has_builtin(__type_pack_element)
+#define UL_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
 
-template <IsUnitLeaf... Prefix, IsUnitLeaf H, IsUnitLeaf... T>
-struct ULSortRecurse<UnitLeafVector<Prefix...>, UnitLeafVector<H, T...>>
-{
-    using min = ULMin<UnitLeafVector<H, T...>>;
-    using rest = ULRemoveFirst<min, UnitLeafVector<H, T...>>;
-    using type = typename ULSortRecurse<ULAppend<min, UnitLeafVector<Prefix...>>, rest>::type;
-};
+#ifdef UL_HAS_TYPE_PACK_ELEMENT
+template <size_t I, typename... Ts>
+using ULAt = __type_pack_element<I, Ts...>;
+#else
+template <size_t I, typename... Ts>
+using ULAt = std::tuple_element_t<I, std::tuple<Ts...>>;
+#endif
 
-template <IsUnitLeaf... Prefix, IsUnitLeaf... T>
-    requires(sizeof...(T) == 0)
-struct ULSortRecurse<UnitLeafVector<Prefix...>, UnitLeafVector<T...>>
+/** @brief One leaf of a flattened vector: the first source leaf with its symbol, and the summed exponent */
+struct ULFlatLeaf_
 {
-    using type = UnitLeafVector<Prefix...>;
+    size_t source = 0;
+    size_t count = 0;
+    intmax_t num = 0;
+    intmax_t den = 1;
 };
 
-template <typename T>
-struct ULSort_;
-
-template <IsUnitLeaf... T>
-struct ULSort_<UnitLeafVector<T...>>
+template <size_t N>
+struct ULFlatVector_
 {
-    using type = typename ULSortRecurse<UnitLeafVector<>, UnitLeafVector<T...>>::type;
+    std::array<ULFlatLeaf_, N> leaves{};
+    size_t size = 0;
 };
 
-template <typename V>
-    requires(IsUnitLeafVector<V>)
-using ULSort = typename ULSort_<V>::type;
-
-/** Merge duplicates in a list */
-
-template <typename V>
+/**
+ * @brief Run the selected canonicalization steps over `N` leaves, given their
+ * symbols and exponents. Symbols are ordered and compared the same way as
+ * `ULCompare`/`ULIsSameSymbol`. Only depends on `N`, so it is instantiated once
+ * per vector length rather than once per vector.
+ */
+template <size_t N>
+constexpr ULFlatVector_<N> ULFlatten_(const std::array<const char *, N> &symbols,
+                                      const std::array<size_t, N> &lengths,
+                                      const std::array<intmax_t, N> &nums,
+                                      const std::array<intmax_t, N> &dens,
+                                      bool sort, bool merge, bool removeZero)
+{
+    ULFlatVector_<N> res;
+
+    // Insertion sort of leaf indices by symbol
+    std::array<size_t, N> order{};
+    for (size_t i = 0; i < N; i++)
+    {
+        order[i] = i;
+        for (size_t j = i; sort && j > 0 && const_strcmp(symbols[order[j]], symbols[order[j - 1]]) > 0; j--)
+        {
+            std::swap(order[j], order[j - 1]);
+        }
+    }
+
+    // Merge runs of the same symbol, summing their exponents
+    for (size_t idx : order)
+    {
+        if (merge && res.size > 0 &&
+            lengths[res.leaves[res.size - 1].source] == lengths[idx] &&
+            const_strcmp(symbols[res.leaves[res.size - 1].source], symbols[idx]) == 0)
+        {
+            ULFlatLeaf_ &last = res.leaves[res.size - 1];
+            intmax_t g = std::gcd(last.den, dens[idx]);
+            intmax_t num = last.num * (dens[idx] / g) + nums[idx] * (last.den / g);
+            intmax_t den = last.den * (dens[idx] / g);
+            intmax_t r = std::gcd(num, den);
+            last.num = num / r;
+            last.den = den / r;
+            last.count++;
+        }
+        else
+        {
+            res.leaves[res.size++] = {idx, 1, nums[idx], dens[idx]};
+        }
+    }
+
+    // Drop leaves whose exponent is zero
+    if (removeZero)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < res.size; i++)
+        {
+            if (res.leaves[i].num != 0)
+            {
+                res.leaves[kept++] = res.leaves[i];
+            }
+        }
+        res.size = kept;
+    }
+    return res;
+}
+
+/** @brief Leaf type of a flattened entry. Unmerged leaves pass through unchanged */
+template <typename Src, size_t Count, intmax_t Num, intmax_t Den>
+struct ULFlatLeafType_
+{
+    using type = UnitLeaf<Src::symbol, std::ratio<Num, Den>>;
+};
+
+template <typename Src, intmax_t Num, intmax_t Den>
+struct ULFlatLeafType_<Src, 1, Num, Den>
+{
+    using type = Src;
+};
+
+/** @brief Expand a flattened vector back into a UnitLeafVector */
+template <typename Flat, typename Is>
+struct ULExpandFlat_;
+
+template <typename Flat, size_t... Is>
+struct ULExpandFlat_<Flat, std::index_sequence<Is...>>
+{
+    using type = UnitLeafVector<typename Flat::template Leaf<Is>...>;
+};
+
+template <bool Sort, bool Merge, bool RemoveZero, typename V>
     requires(IsUnitLeafVector<V>)
-struct ULMerge_;
+struct ULCanonicalize_;
 
-template <IsUnitLeaf H1, IsUnitLeaf H2, IsUnitLeaf... T>
-    requires ULIsSameSymbol<H1, H2>
-struct ULMerge_<UnitLeafVector<H1, H2, T...>> // if there are duplicates, merge
+template <bool Sort, bool Merge, bool RemoveZero, IsUnitLeaf... Ts>
+struct ULCanonicalize_<Sort, Merge, RemoveZero, UnitLeafVector<Ts...>>
 {
-    using Combined = ULCombine<H1, H2>;
-    using type = typename ULMerge_<UnitLeafVector<Combined, T...>>::type;
-};
+    static constexpr size_t N = sizeof...(Ts);
+    static constexpr ULFlatVector_<N> flat = ULFlatten_<N>(std::array<const char *, N>{Ts::symbol.data...},
+                                                           std::array<size_t, N>{decltype(Ts::symbol)::n...},
+                                                           std::array<intmax_t, N>{Ts::exponent::num...},
+                                                           std::array<intmax_t, N>{Ts::exponent::den...},
+                                                           Sort, Merge, RemoveZero);
 
-template <IsUnitLeaf H, IsUnitLeaf... T> // if there are no duplicates, go to next index
-struct ULMerge_<UnitLeafVector<H, T...>>
-{
-    using type = ULPrepend<H, typename ULMerge_<UnitLeafVector<T...>>::type>;
-};
+    template <size_t I>
+    using Leaf = typename ULFlatLeafType_<ULAt<flat.leaves[I].source, Ts...>,
+                                          flat.leaves[I].count,
+                                          flat.leaves[I].num,
+                                          flat.leaves[I].den>::type;
 
-template <IsUnitLeaf... T>
-    requires(sizeof...(T) == 0) // if we've reached the end
-struct ULMerge_<UnitLeafVector<T...>>
-{
-    using type = UnitLeafVector<T...>;
+    using type = typename ULExpandFlat_<ULCanonicalize_, std::make_index_sequence<flat.size>>::type;
 };
 
+/** Sort a UnitLeafVector by symbol */
 template <typename V>
     requires(IsUnitLeafVector<V>)
-using ULMerge = typename ULMerge_<V>::type;
+using ULSort = typename ULCanonicalize_<true, false, false, V>::type;
 
-/** Remove exp 0 */
+/** Merge adjacent duplicates in a list */
 template <typename V>
     requires(IsUnitLeafVector<V>)
-struct ULRemoveZero_;
-
-template <IsUnitLeaf H, IsUnitLeaf... T>
-    requires(ULIsZero<H>)
-struct ULRemoveZero_<UnitLeafVector<H, T...>>
-{
-    using type = typename ULRemoveZero_<UnitLeafVector<T...>>::type;
-};
-
-template <IsUnitLeaf H, IsUnitLeaf... T>
-    requires(!ULIsZero<H>)
-struct ULRemoveZero_<UnitLeafVector<H, T...>>
-{
-    using type = ULPrepend<H, typename ULRemoveZero_<UnitLeafVector<T...>>::type>;
-};
-
-template <IsUnitLeaf... T>
-    requires(sizeof...(T) == 0)
-struct ULRemoveZero_<UnitLeafVector<T...>>
-{
-    using type = UnitLeafVector<T...>;
-};
+using ULMerge = typename ULCanonicalize_<false, true, false, V>::type;
 
+/** Remove exp 0 */
 template <typename V>
     requires(IsUnitLeafVector<V>)
-using ULRemoveZero = typename ULRemoveZero_<V>::type;
+using ULRemoveZero = typename ULCanonicalize_<false, false, true, V>::type;
 
 /** GetUnique - sort, combine exponents and remove zeros */
 template <typename V>
     requires(IsUnitLeafVector<V>)
-using ULGetUnique = ULRemoveZero<ULMerge<ULSort<V>>>;
+using ULGetUnique = typename ULCanonicalize_<true, true, true, V>::type;
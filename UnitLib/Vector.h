@@ -7,6 +7,7 @@
 #pragma once
 
 #include "TypeUtils.h"
+#include "Simd.h"
 #include <initializer_list>
 
 //--------------------------------------------------------------------------------
@@ -265,6 +266,13 @@ public:
         requires CanAdd<Type, RHS>
     inline VectorN<AddType<Type, RHS>> operator+(const VectorN<RHS> &rhs) const
     {
+        if constexpr (N == 4 && std::is_same_v<Type, RHS> && std::is_same_v<AddType<Type, RHS>, Type> && SimdCompatible<Type>)
+        {
+            VectorN<Type> res;
+            SimdAdd4(SimdPtr(_v.data()), SimdPtr(&rhs[0]), SimdPtr(&res[0]));
+            return res;
+        }
+
         return ([&]<size_t... Is>(std::index_sequence<Is...>) constexpr
                 {
                     return VectorN<AddType<Type, RHS>>{(_v[Is] + rhs[Is])...}; // Expands the expression for each index
@@ -276,6 +284,13 @@ public:
         requires CanSubtract<Type, RHS>
     inline VectorN<SubtractType<Type, RHS>> operator-(const VectorN<RHS> &rhs) const
     {
+        if constexpr (N == 4 && std::is_same_v<Type, RHS> && std::is_same_v<SubtractType<Type, RHS>, Type> && SimdCompatible<Type>)
+        {
+            VectorN<Type> res;
+            SimdSub4(SimdPtr(_v.data()), SimdPtr(&rhs[0]), SimdPtr(&res[0]));
+            return res;
+        }
+
         return ([&]<size_t... Is>(std::index_sequence<Is...>) constexpr
                 {
                     return VectorN<SubtractType<Type, RHS>>{(_v[Is] - rhs[Is])...}; // Expands the expression for each index
@@ -287,6 +302,13 @@ public:
         requires CanMultiply<Type, RHS>
     inline VectorN<MultiplyType<Type, RHS>> operator*(const VectorN<RHS> &rhs) const
     {
+        if constexpr (N == 4 && SimdCompatible<Type, RHS, MultiplyType<Type, RHS>>)
+        {
+            VectorN<MultiplyType<Type, RHS>> res;
+            SimdMul4(SimdPtr(_v.data()), SimdPtr(&rhs[0]), SimdPtr(&res[0]));
+            return res;
+        }
+
         return ([&]<size_t... Is>(std::index_sequence<Is...>) constexpr
                 {
                     return VectorN<MultiplyType<Type, RHS>>{(_v[Is] * rhs[Is])...}; // Expands the expression for each index
@@ -417,7 +439,7 @@ public:
     }
 
 private:
-    Array<Type, N> _v;
+    alignas(SimdAlignment<N, Type>()) Array<Type, N> _v;
 };
 
 // Some aliases
@@ -465,6 +487,13 @@ template <typename LHS_VecType, size_t N, typename RHS_Type>
              CanMultiply<LHS_VecType, RHS_Type>)
 inline Vector<N, MultiplyType<LHS_VecType, RHS_Type>> operator*(const Vector<N, LHS_VecType> &lhs_v, const RHS_Type &rhs)
 {
+    if constexpr (N == 4 && SimdCompatible<LHS_VecType, RHS_Type, MultiplyType<LHS_VecType, RHS_Type>>)
+    {
+        Vector<N, MultiplyType<LHS_VecType, RHS_Type>> res;
+        SimdScale4(SimdPtr(&lhs_v[0]), *SimdPtr(&rhs), SimdPtr(&res[0]));
+        return res;
+    }
+
     return ([&]<size_t... Is>(std::index_sequence<Is...>) constexpr
             {
                 return Vector<N, MultiplyType<LHS_VecType, RHS_Type>>{(lhs_v[Is] * rhs)...}; // Expands the expression for each index
@@ -477,6 +506,13 @@ template <typename RHS_VecType, size_t N, typename LHS_Type>
              CanMultiply<LHS_Type, RHS_VecType>)
 inline Vector<N, MultiplyType<LHS_Type, RHS_VecType>> operator*(const LHS_Type &lhs, const Vector<N, RHS_VecType> &rhs_v)
 {
+    if constexpr (N == 4 && SimdCompatible<LHS_Type, RHS_VecType, MultiplyType<LHS_Type, RHS_VecType>>)
+    {
+        Vector<N, MultiplyType<LHS_Type, RHS_VecType>> res;
+        SimdScale4(SimdPtr(&rhs_v[0]), *SimdPtr(&lhs), SimdPtr(&res[0]));
+        return res;
+    }
+
     return ([&]<size_t... Is>(std::index_sequence<Is...>) constexpr
             {
                 return Vector<N, MultiplyType<LHS_Type, RHS_VecType>>{(lhs * rhs_v[Is])...}; // Expands the expression for each index
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "UnitMath.h"
 
 /** @brief Helper concept to check if a type supports norm */
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../PhysicsLib/Actor.h"
+#include "BenchUtils.h"
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Actor benchmarks
+//
+//   Stepping N spinning actors: per-actor Update with std::cos/std::sin, the
+//   same with incremental rotation, one UpdateAll pass with batched trig, and
+//   a unit-typed Actor<meter, second>, which should match the plain one
+//------------------------------------------------------------------------------
+
+inline void RunActorBenchmarks()
+{
+    PrintHeader("Actor");
+
+    constexpr size_t NUM_ACTORS = 4096;
+    constexpr double DT = 1.0 / 60;
+
+    auto MakeActors = [](RotationMode mode)
+    {
+        std::vector<Actor<double>> actors;
+        for (size_t i = 0; i < NUM_ACTORS; i++)
+        {
+            double f = static_cast<double>(i);
+            actors.emplace_back(Vector2<double>{f, -f}, Vector2<double>{1.0, 0.5}, f * 0.01, 0.5 + (i % 7) * 0.1);
+            actors.back().rotationMode = mode;
+        }
+        return actors;
+    };
+
+    std::vector<Actor<double>> exact = MakeActors(RotationMode::Exact);
+    PrintResult(RunBench("Update (exact trig), 4096 actors", 500, [&]()
+                         {
+                             for (Actor<double> &actor : exact)
+                             {
+                                 actor.Update(DT);
+                             }
+                             ClobberMemory(); }));
+
+    std::vector<Actor<double>> incremental = MakeActors(RotationMode::Incremental);
+    PrintResult(RunBench("Update (incremental), 4096 actors", 500, [&]()
+                         {
+                             for (Actor<double> &actor : incremental)
+                             {
+                                 actor.Update(DT);
+                             }
+                             ClobberMemory(); }));
+
+    std::vector<Actor<double>> batched = MakeActors(RotationMode::Exact);
+    PrintResult(RunBench("UpdateAll (exact trig), 4096 actors", 500, [&]()
+                         {
+                             Actor<double>::UpdateAll(batched, DT);
+                             ClobberMemory(); }));
+
+    using Meter = dAtomic<"meter">;
+    using Second = dAtomic<"second">;
+    using UnitActor = Actor<Meter, Second>;
+    std::vector<UnitActor> typed;
+    for (size_t i = 0; i < NUM_ACTORS; i++)
+    {
+        double f = static_cast<double>(i);
+        typed.emplace_back(Vector2<Meter>{Meter{f}, Meter{-f}},
+                           Vector2<UnitActor::Velocity>{UnitActor::Velocity{1.0}, UnitActor::Velocity{0.5}},
+                           f * 0.01, UnitActor::AngularSpeed{0.5 + (i % 7) * 0.1});
+    }
+    PrintResult(RunBench("Update (exact trig, unit-typed), 4096 actors", 500, [&]()
+                         {
+                             for (UnitActor &actor : typed)
+                             {
+                                 actor.Update(Second{DT});
+                             }
+                             ClobberMemory(); }));
+}
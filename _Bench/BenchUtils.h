@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+//------------------------------------------------------------------------------
+// Benchmark helpers
+//------------------------------------------------------------------------------
+
+/** @brief Keep the compiler from optimizing away a value */
+template <typename T>
+inline void DoNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** @brief Keep the compiler from reordering or eliding memory writes around this point */
+inline void ClobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+struct BenchResult
+{
+    std::string name;
+    size_t iterations;
+    double nsPerOp;
+};
+
+/**
+ * @brief Time `iterations` calls of `fn` (after a short warm-up) and return ns per call.
+ * `fn` should route its result through DoNotOptimize.
+ */
+template <typename Fn>
+inline BenchResult RunBench(const std::string &name, size_t iterations, Fn &&fn)
+{
+    for (size_t i = 0; i < iterations / 10 + 1; i++)
+    {
+        fn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return {name, iterations, ns / static_cast<double>(iterations)};
+}
+
+inline void PrintHeader(const std::string &title)
+{
+    std::cout << std::endl
+              << "------ " << title << " ------" << std::endl;
+}
+
+inline void PrintResult(const BenchResult &result)
+{
+    std::cout << std::left << std::setw(40) << result.name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << result.nsPerOp << " ns/op"
+              << std::endl;
+}
+
+inline void PrintBytes(const std::string &name, size_t bytes)
+{
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(12) << bytes << " bytes"
+              << std::endl;
+}
+
+/** @brief Print a UnitLib timing next to its raw baseline, with their ratio */
+inline void PrintComparison(const std::string &name, const BenchResult &unit, const BenchResult &raw)
+{
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << unit.nsPerOp << " ns/op"
+              << std::setw(10) << raw.nsPerOp << " ns/op"
+              << std::setw(10) << unit.nsPerOp / raw.nsPerOp << "x"
+              << std::endl;
+}
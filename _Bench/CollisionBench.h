@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../PhysicsLib/AABBSet.h"
+#include "../PhysicsLib/Collision.h"
+#include "BenchUtils.h"
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Collision benchmarks
+//
+//   All-pairs overlap tests over N boxes: CheckCollision on an array of AABB
+//   structs versus the AABBSet block kernel over SoA edges
+//------------------------------------------------------------------------------
+
+inline void RunCollisionBenchmarks()
+{
+    PrintHeader("Collision");
+
+    constexpr size_t NUM_BOXES = 256;
+
+    std::mt19937 gen{42};
+    std::uniform_real_distribution<double> pos{0, 100};
+    std::uniform_real_distribution<double> size{1, 8};
+
+    std::vector<AABB> boxes;
+    AABBSet set;
+    for (size_t i = 0; i < NUM_BOXES; i++)
+    {
+        AABB box = {pos(gen), pos(gen), size(gen), size(gen)};
+        boxes.push_back(box);
+        set.Add(box);
+    }
+
+    PrintResult(RunBench("CheckCollision all pairs, 256 boxes", 2000, [&]()
+                         {
+                             size_t pairs = 0;
+                             for (size_t i = 0; i < boxes.size(); i++)
+                             {
+                                 for (size_t j = i + 1; j < boxes.size(); j++)
+                                 {
+                                     pairs += CheckCollision(boxes[i], boxes[j]);
+                                 }
+                             }
+                             DoNotOptimize(pairs); }));
+
+    PrintResult(RunBench("AABBSet::CountPairs, 256 boxes", 2000, [&]()
+                         { DoNotOptimize(set.CountPairs()); }));
+
+    PrintResult(RunBench("AABBSet::ForEachPair, 256 boxes", 2000, [&]()
+                         {
+                             size_t sum = 0;
+                             set.ForEachPair([&](size_t i, size_t j)
+                                             { sum += i ^ j; });
+                             DoNotOptimize(sum); }));
+}
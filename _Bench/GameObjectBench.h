@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../Game.h"
+#include "BenchUtils.h"
+#include <vector>
+
+//------------------------------------------------------------------------------
+// GameObject benchmarks
+//
+//   Memory footprint and update cost of a GameObject hierarchy shaped like the
+//   asteroid scene (each root object has a child which has a grandchild)
+//------------------------------------------------------------------------------
+
+template <size_t Depth>
+class BenchObject : public GameObject<Depth>
+{
+public:
+    inline virtual void Update() override
+    {
+        this->pos += this->vel * 1_frame;
+        GameObject<Depth>::Update();
+    }
+    inline virtual void Draw() override {};
+};
+
+class BenchRoot : public BenchObject<0>
+{
+public:
+    inline virtual void Initialize() override
+    {
+        auto *child = AddChild<BenchObject>();
+        child->AddChild<BenchObject>();
+    }
+};
+
+inline void RunGameObjectBenchmarks()
+{
+    PrintHeader("GameObject");
+
+    constexpr size_t NUM_OBJECTS = MAX_GAME_OBJECTS;
+    PrintBytes("sizeof(GameObject<0>)", sizeof(GameObject<0>));
+    PrintBytes("hierarchy bytes (1024 x 3 objects)", NUM_OBJECTS * (sizeof(BenchRoot) + 2 * sizeof(BenchObject<1>)));
+
+    std::vector<BenchRoot *> roots;
+    for (size_t i = 0; i < NUM_OBJECTS; i++)
+    {
+        BenchRoot *root = new BenchRoot();
+        root->Initialize();
+        root->SetVel({1, 1});
+        roots.push_back(root);
+    }
+
+    PrintResult(RunBench("Update 1024 hierarchies", 1000, [&]()
+                         {
+                             for (BenchRoot *root : roots)
+                             {
+                                 root->Update();
+                             }
+                             ClobberMemory(); }));
+
+    for (BenchRoot *root : roots)
+    {
+        delete root;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../Game.h"
+#include "BenchUtils.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Kinematics benchmarks
+//
+//   Integrating N bodies one virtual Update at a time (objects own pos/vel/acc)
+//   versus a single KinematicStore::Integrate pass over SoA arrays
+//------------------------------------------------------------------------------
+
+class BenchBody : public GameObject<0>
+{
+public:
+    inline virtual void Update() override
+    {
+        vel += acc * 1_frame;
+        pos += vel * 1_frame;
+    }
+    inline virtual void Draw() override {};
+
+    inline void SetAcc(Vector2<World_per_Frame_2> acc_)
+    {
+        acc = acc_;
+    }
+};
+
+inline void RunKinematicsBenchmarks()
+{
+    PrintHeader("Kinematics");
+
+    constexpr size_t NUM_BODIES = 16384;
+
+    std::vector<Entity *> bodies;
+    KinematicStore<kWrapNone> store;
+    store.Reserve(NUM_BODIES);
+    for (size_t i = 0; i < NUM_BODIES; i++)
+    {
+        double f = static_cast<double>(i);
+        BenchBody *body = new BenchBody();
+        body->SetPos({f, -f});
+        body->SetVel({0.1, 0.2});
+        body->SetAcc({0.001, -0.001});
+        bodies.push_back(body);
+
+        store.Add({f, -f}, {0.1, 0.2}, {0.001, -0.001});
+    }
+    // Objects churn over a game's lifetime, so their heap order rarely matches update order
+    std::shuffle(bodies.begin(), bodies.end(), std::mt19937{42});
+
+    PrintResult(RunBench("Virtual Update, 16384 bodies", 2000, [&]()
+                         {
+                             for (Entity *body : bodies)
+                             {
+                                 body->Update();
+                             }
+                             ClobberMemory(); }));
+
+    PrintResult(RunBench("KinematicStore::Integrate, 16384 bodies", 2000, [&]()
+                         {
+                             store.Integrate(1_frame);
+                             ClobberMemory(); }));
+
+    XBounds::SetLowerBound(0);
+    XBounds::SetUpperBound(DEFAULT_WIDTH);
+    YBounds::SetLowerBound(0);
+    YBounds::SetUpperBound(DEFAULT_HEIGHT);
+
+    KinematicStore<kWrapBoth> wrapStore;
+    wrapStore.Reserve(NUM_BODIES);
+    for (size_t i = 0; i < NUM_BODIES; i++)
+    {
+        wrapStore.Add({static_cast<double>(i % 300), 10}, {0.1, 0.2});
+    }
+
+    PrintResult(RunBench("Integrate (wrapped), 16384 bodies", 2000, [&]()
+                         {
+                             wrapStore.Integrate(1_frame);
+                             ClobberMemory(); }));
+
+    for (Entity *body : bodies)
+    {
+        delete body;
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "BenchUtils.h"
+#include "UnitLibKernels.h"
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// UnitLib benchmarks
+//
+//   Times each UnitKernel_* against its RawKernel_* twin over the same inputs.
+//   UnitLib promises zero overhead relative to primitive types, so the ratio
+//   column should stay at ~1.00x; anything well above that is a regression.
+//------------------------------------------------------------------------------
+
+constexpr size_t UNITLIB_BENCH_ELEMENTS = 1024;
+constexpr size_t UNITLIB_BENCH_ITERATIONS = 2000;
+
+/**
+ * @brief Fill a UnitLib array and its raw twin with the same random bits.
+ * Both types must have identical size and be trivially copyable.
+ */
+template <typename UnitT, typename RawT>
+inline void FillPair_(std::vector<UnitT> &unit, std::vector<RawT> &raw, std::mt19937 &rng)
+{
+    static_assert(sizeof(UnitT) == sizeof(RawT), "Unit and raw element sizes differ");
+    static_assert(std::is_trivially_copyable_v<UnitT> && std::is_trivially_copyable_v<RawT>);
+
+    unit.resize(UNITLIB_BENCH_ELEMENTS);
+    raw.resize(UNITLIB_BENCH_ELEMENTS);
+
+    using Scalar = std::conditional_t<std::is_same_v<RawT, RawMat4f>, float, double>;
+    constexpr size_t scalars = sizeof(RawT) / sizeof(Scalar);
+    std::uniform_real_distribution<Scalar> dist{1, 2};
+    for (RawT &element : raw)
+    {
+        Scalar values[scalars];
+        for (Scalar &v : values)
+        {
+            v = dist(rng);
+        }
+        std::memcpy(&element, values, sizeof(RawT));
+    }
+    // Layouts are identical; the cast only silences -Wclass-memaccess on non-trivial default ctors
+    std::memcpy(static_cast<void *>(unit.data()), raw.data(), sizeof(RawT) * raw.size());
+}
+
+/** @brief Time a kernel call over UNITLIB_BENCH_ELEMENTS elements, reporting ns per element */
+template <typename Fn>
+inline BenchResult RunKernelBench_(const std::string &name, Fn &&fn)
+{
+    BenchResult result = RunBench(name, UNITLIB_BENCH_ITERATIONS, [&]()
+                                  {
+                                      fn();
+                                      ClobberMemory(); });
+    result.nsPerOp /= static_cast<double>(UNITLIB_BENCH_ELEMENTS);
+    return result;
+}
+
+/** @brief Binary kernel pair: out[i] = op(a[i], b[i]) */
+template <typename UA, typename UB, typename UOut, typename RA, typename RB, typename ROut>
+inline void CompareBinary_(const std::string &name,
+                           void (*unitKernel)(const UA *, const UB *, UOut *, size_t),
+                           void (*rawKernel)(const RA *, const RB *, ROut *, size_t))
+{
+    std::mt19937 rng{7};
+    std::vector<UA> ua;
+    std::vector<RA> ra;
+    std::vector<UB> ub;
+    std::vector<RB> rb;
+    FillPair_(ua, ra, rng);
+    FillPair_(ub, rb, rng);
+    std::vector<UOut> uout(UNITLIB_BENCH_ELEMENTS);
+    std::vector<ROut> rout(UNITLIB_BENCH_ELEMENTS);
+
+    BenchResult unit = RunKernelBench_(name, [&]()
+                                       { unitKernel(ua.data(), ub.data(), uout.data(), UNITLIB_BENCH_ELEMENTS); });
+    BenchResult raw = RunKernelBench_(name, [&]()
+                                      { rawKernel(ra.data(), rb.data(), rout.data(), UNITLIB_BENCH_ELEMENTS); });
+    PrintComparison(name, unit, raw);
+}
+
+/** @brief Unary kernel pair: out[i] = op(a[i]) */
+template <typename UA, typename UOut, typename RA, typename ROut>
+inline void CompareUnary_(const std::string &name,
+                          void (*unitKernel)(const UA *, UOut *, size_t),
+                          void (*rawKernel)(const RA *, ROut *, size_t))
+{
+    std::mt19937 rng{7};
+    std::vector<UA> ua;
+    std::vector<RA> ra;
+    FillPair_(ua, ra, rng);
+    std::vector<UOut> uout(UNITLIB_BENCH_ELEMENTS);
+    std::vector<ROut> rout(UNITLIB_BENCH_ELEMENTS);
+
+    BenchResult unit = RunKernelBench_(name, [&]()
+                                       { unitKernel(ua.data(), uout.data(), UNITLIB_BENCH_ELEMENTS); });
+    BenchResult raw = RunKernelBench_(name, [&]()
+                                      { rawKernel(ra.data(), rout.data(), UNITLIB_BENCH_ELEMENTS); });
+    PrintComparison(name, unit, raw);
+}
+
+inline void RunUnitLibBenchmarks()
+{
+    PrintHeader("UnitLib vs raw (unit, raw, ratio)");
+
+    CompareBinary_("Unit +", UnitKernel_UnitAdd, RawKernel_UnitAdd);
+    CompareBinary_("Unit *", UnitKernel_UnitMul, RawKernel_UnitMul);
+    CompareBinary_("Unit /", UnitKernel_UnitDiv, RawKernel_UnitDiv);
+    CompareUnary_("Kilometer -> Meter", UnitKernel_RatioConvert, RawKernel_RatioConvert);
+    CompareBinary_("Kilometer + Meter", UnitKernel_RatioAdd, RawKernel_RatioAdd);
+
+    CompareBinary_("Vector3 +", UnitKernel_Vec3Add, RawKernel_Vec3Add);
+    CompareBinary_("Vector3 Dot", UnitKernel_Vec3Dot, RawKernel_Vec3Dot);
+    CompareBinary_("Vector3 Cross", UnitKernel_Vec3Cross, RawKernel_Vec3Cross);
+    CompareUnary_("Vector3 NormSquared", UnitKernel_Vec3NormSquared, RawKernel_Vec3NormSquared);
+
+    CompareBinary_("Matrix3 *", UnitKernel_Mat3Mul, RawKernel_Mat3Mul);
+    CompareBinary_("Matrix4<float> *", UnitKernel_Mat4fMul, RawKernel_Mat4fMul);
+    CompareUnary_("Matrix3 Det", UnitKernel_Mat3Det, RawKernel_Mat3Det);
+    CompareUnary_("Matrix3 Inv", UnitKernel_Mat3Inv, RawKernel_Mat3Inv);
+
+    PrintBytes("sizeof(Vector3<Meter>)", sizeof(Vector3<BenchMeter>));
+    PrintBytes("sizeof(RawVec3)", sizeof(RawVec3));
+    PrintBytes("sizeof(Matrix3<Meter>)", sizeof(Matrix3<BenchMeter>));
+    PrintBytes("sizeof(RawMat3)", sizeof(RawMat3));
+}
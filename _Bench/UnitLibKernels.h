@@ -0,0 +1,316 @@
+#pragma once
+
+#include "../UnitLib/Matrix.h"
+#include "../UnitLib/Unit.h"
+#include "../UnitLib/UnitMath.h"
+#include "../UnitLib/Vector.h"
+#include <cstddef>
+
+//------------------------------------------------------------------------------
+// UnitLib kernels
+//
+//   Every UnitLib operation we benchmark is written twice: once against UnitLib
+//   types (UnitKernel_*) and once by hand against plain doubles/floats in the
+//   style of a glm-like math library (RawKernel_*). Both versions of a pair
+//   must compute exactly the same thing.
+//
+//   Kernels are extern "C" and never inlined, so each one is emitted as its own
+//   symbol. `_Bench/instr-count.sh` disassembles them by name and compares the
+//   instruction counts of each pair; RunUnitLibBenchmarks times them.
+//------------------------------------------------------------------------------
+
+#define BENCH_KERNEL extern "C" [[gnu::noinline]]
+
+using BenchMeter = dAtomic<"meter">;
+using BenchSecond = dAtomic<"second">;
+using BenchKilometer = UnitMultRatio<BenchMeter, std::ratio<1000>>;
+using BenchMeterSecond = MultiplyType<BenchMeter, BenchSecond>;
+using BenchMeter_2 = MultiplyType<BenchMeter, BenchMeter>;
+using BenchMeter_3 = MultiplyType<BenchMeter_2, BenchMeter>;
+using BenchMeter__1 = InvertType<BenchMeter>;
+using fBenchMeter = fAtomic<"meter">;
+
+/** @brief glm-style baseline types */
+struct RawVec3
+{
+    double x, y, z;
+};
+
+struct RawMat3
+{
+    double m[3][3];
+};
+
+struct RawMat4f
+{
+    float m[4][4];
+};
+
+//------------------------------------------------------------------------------
+// Unit arithmetic
+//------------------------------------------------------------------------------
+
+BENCH_KERNEL void UnitKernel_UnitAdd(const BenchMeter *a, const BenchMeter *b, BenchMeter *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_UnitAdd(const double *a, const double *b, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+BENCH_KERNEL void UnitKernel_UnitMul(const BenchMeter *a, const BenchSecond *b, BenchMeterSecond *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_UnitMul(const double *a, const double *b, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+BENCH_KERNEL void UnitKernel_UnitDiv(const BenchMeter *a, const BenchSecond *b, DivideType<BenchMeter, BenchSecond> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] / b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_UnitDiv(const double *a, const double *b, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] / b[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+// Ratio conversions
+//------------------------------------------------------------------------------
+
+BENCH_KERNEL void UnitKernel_RatioConvert(const BenchKilometer *a, BenchMeter *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_RatioConvert(const double *a, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * 1000.0;
+    }
+}
+
+BENCH_KERNEL void UnitKernel_RatioAdd(const BenchKilometer *a, const BenchMeter *b, BenchMeter *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_RatioAdd(const double *a, const double *b, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * 1000.0 + b[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+// Vector operations
+//------------------------------------------------------------------------------
+
+BENCH_KERNEL void UnitKernel_Vec3Add(const Vector3<BenchMeter> *a, const Vector3<BenchMeter> *b, Vector3<BenchMeter> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] + b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_Vec3Add(const RawVec3 *a, const RawVec3 *b, RawVec3 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = {a[i].x + b[i].x, a[i].y + b[i].y, a[i].z + b[i].z};
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Vec3Dot(const Vector3<BenchMeter> *a, const Vector3<BenchMeter> *b, BenchMeter_2 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i].Dot(b[i]);
+    }
+}
+
+BENCH_KERNEL void RawKernel_Vec3Dot(const RawVec3 *a, const RawVec3 *b, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Vec3Cross(const Vector3<BenchMeter> *a, const Vector3<BenchMeter> *b, Vector3<BenchMeter_2> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i].Cross(b[i]);
+    }
+}
+
+BENCH_KERNEL void RawKernel_Vec3Cross(const RawVec3 *a, const RawVec3 *b, RawVec3 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = {a[i].y * b[i].z - a[i].z * b[i].y,
+                  a[i].z * b[i].x - a[i].x * b[i].z,
+                  a[i].x * b[i].y - a[i].y * b[i].x};
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Vec3NormSquared(const Vector3<BenchMeter> *a, BenchMeter_2 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = NormSquared(a[i]);
+    }
+}
+
+BENCH_KERNEL void RawKernel_Vec3NormSquared(const RawVec3 *a, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i].x * a[i].x + a[i].y * a[i].y + a[i].z * a[i].z;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Matrix operations
+//------------------------------------------------------------------------------
+
+BENCH_KERNEL void UnitKernel_Mat3Mul(const Matrix3<BenchMeter> *a, const Matrix3<BenchMeter> *b, Matrix3<BenchMeter_2> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_Mat3Mul(const RawMat3 *a, const RawMat3 *b, RawMat3 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t r = 0; r < 3; r++)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                out[i].m[r][c] = a[i].m[r][0] * b[i].m[0][c] +
+                                 a[i].m[r][1] * b[i].m[1][c] +
+                                 a[i].m[r][2] * b[i].m[2][c];
+            }
+        }
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Mat4fMul(const Matrix4<fBenchMeter> *a, const Matrix4<fBenchMeter> *b,
+                                      Matrix4<MultiplyType<fBenchMeter, fBenchMeter>> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
+BENCH_KERNEL void RawKernel_Mat4fMul(const RawMat4f *a, const RawMat4f *b, RawMat4f *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t r = 0; r < 4; r++)
+        {
+            for (size_t c = 0; c < 4; c++)
+            {
+                out[i].m[r][c] = a[i].m[r][0] * b[i].m[0][c] +
+                                 a[i].m[r][1] * b[i].m[1][c] +
+                                 a[i].m[r][2] * b[i].m[2][c] +
+                                 a[i].m[r][3] * b[i].m[3][c];
+            }
+        }
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Mat3Det(const Matrix3<BenchMeter> *a, BenchMeter_3 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = Det(a[i]);
+    }
+}
+
+inline double RawDet3_(const RawMat3 &a)
+{
+    return a.m[0][0] * (a.m[1][1] * a.m[2][2] - a.m[1][2] * a.m[2][1]) -
+           a.m[0][1] * (a.m[1][0] * a.m[2][2] - a.m[1][2] * a.m[2][0]) +
+           a.m[0][2] * (a.m[1][0] * a.m[2][1] - a.m[1][1] * a.m[2][0]);
+}
+
+BENCH_KERNEL void RawKernel_Mat3Det(const RawMat3 *a, double *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = RawDet3_(a[i]);
+    }
+}
+
+BENCH_KERNEL void UnitKernel_Mat3Inv(const Matrix3<BenchMeter> *a, Matrix3<BenchMeter__1> *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = Inv(a[i]);
+    }
+}
+
+BENCH_KERNEL void RawKernel_Mat3Inv(const RawMat3 *a, RawMat3 *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const RawMat3 &m = a[i];
+        double d = RawDet3_(m);
+        if (d == 0)
+        {
+            out[i] = {};
+            continue;
+        }
+        // Adjugate (transposed cofactors) over the determinant
+        out[i].m[0][0] = (m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1]) / d;
+        out[i].m[0][1] = -(m.m[0][1] * m.m[2][2] - m.m[0][2] * m.m[2][1]) / d;
+        out[i].m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) / d;
+        out[i].m[1][0] = -(m.m[1][0] * m.m[2][2] - m.m[1][2] * m.m[2][0]) / d;
+        out[i].m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) / d;
+        out[i].m[1][2] = -(m.m[0][0] * m.m[1][2] - m.m[0][2] * m.m[1][0]) / d;
+        out[i].m[2][0] = (m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0]) / d;
+        out[i].m[2][1] = -(m.m[0][0] * m.m[2][1] - m.m[0][1] * m.m[2][0]) / d;
+        out[i].m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) / d;
+    }
+}
+
+#undef BENCH_KERNEL
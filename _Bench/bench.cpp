@@ -0,0 +1,18 @@
+#include "ActorBench.h"
+#include "CollisionBench.h"
+#include "GameObjectBench.h"
+#include "KinematicsBench.h"
+#include "UnitLibBench.h"
+
+int main()
+{
+    std::cout << "------ BEGIN BENCHMARKS ------" << std::endl;
+
+    RunActorBenchmarks();
+    RunCollisionBenchmarks();
+    RunGameObjectBenchmarks();
+    RunKinematicsBenchmarks();
+    RunUnitLibBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#!/bin/bash
+# Measure the compile-time cost of UnitLib unit algebra.
+#
+# For each N, generates a translation unit with N atomic units, multiplies them
+# together in both orders and divides them back out, then times its compile
+# (CPU time of the compiler). With clang, the number of template instantiations is counted from
+# -ftime-trace as well.
+#
+# Usage: _Bench/compile-bench.sh [N...]   (default: 4 8 16 24)
+# CXX can be overridden.
+set -e
+
+CXX=${CXX:-clang++}
+SIZES=${@:-4 8 16 24}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Instantiation counts need clang's -ftime-trace
+TRACE=""
+if $CXX --version 2>/dev/null | grep -q clang; then
+    TRACE="-ftime-trace -ftime-trace-granularity=0"
+fi
+
+generate() {
+    local n=$1
+    echo '#include "UnitLib/Unit.h"'
+    for ((i = 0; i < n; i++)); do
+        echo "using U$i = dAtomic<\"u$i\">;"
+    done
+    echo 'int main()'
+    echo '{'
+    for ((i = 0; i < n; i++)); do
+        echo "    U$i u$i{$((i + 1))};"
+    done
+    echo -n '    auto forward = u0'
+    for ((i = 1; i < n; i++)); do echo -n " * u$i"; done
+    echo ';'
+    echo -n "    auto backward = u$((n - 1))"
+    for ((i = n - 2; i >= 0; i--)); do echo -n " * u$i"; done
+    echo ';'
+    echo -n '    auto empty = forward'
+    for ((i = 0; i < n; i++)); do echo -n " / u$i"; done
+    echo ';'
+    echo '    static_assert(std::is_same_v<decltype(forward), decltype(backward)>);'
+    echo '    static_assert(std::is_same_v<decltype(empty)::uid, EmptyUid>);'
+    echo '    return static_cast<int>(empty.GetValue() + backward.GetValue() - forward.GetValue());'
+    echo '}'
+}
+
+# Compiler CPU time (user), which is less noisy than wall time
+TIMEFORMAT=%U
+
+printf "%-8s %12s %16s\n" "units" "user (s)" "instantiations"
+for n in $SIZES; do
+    src="$WORK/units_$n.cpp"
+    generate "$n" > "$src"
+
+    seconds=$( { time (cd "$WORK" && $CXX -std=c++20 -I "$ROOT" $TRACE -c "$src" -o "$WORK/units_$n.o" 2> "$WORK/errors.txt"); } 2>&1 ) || {
+        cat "$WORK/errors.txt"
+        exit 1
+    }
+
+    count="n/a"
+    trace="$WORK/units_$n.json"
+    if [ -n "$TRACE" ] && [ -f "$trace" ]; then
+        count=$(grep -oE '"name":"Instantiate(Class|Function)"' "$trace" | wc -l | tr -d ' ')
+    fi
+    printf "%-8s %12s %16s\n" "$n" "$seconds" "$count"
+done
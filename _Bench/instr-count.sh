@@ -0,0 +1,40 @@
+#!/bin/bash
+# Compare the number of instructions generated for each UnitKernel_*/RawKernel_*
+# pair in _Bench/UnitLibKernels.h.
+#
+# Usage: _Bench/instr-count.sh [object file]
+# Without an argument, _Bench/bench.cpp is compiled to a temporary object with
+# the same flags as `make bench`. CXX and OBJDUMP can be overridden.
+set -e
+
+CXX=${CXX:-clang++}
+OBJDUMP=${OBJDUMP:-objdump}
+
+OBJ=$1
+if [ -z "$OBJ" ]; then
+    OBJ=$(mktemp -t bench.XXXXXX)
+    trap 'rm -f "$OBJ"' EXIT
+    $CXX -Wall -Wextra -std=c++20 -O2 -DNDEBUG -I dependencies/include -c _Bench/bench.cpp -o "$OBJ"
+fi
+
+# Count instruction lines inside each kernel symbol. Mach-O symbols carry a
+# leading underscore, which is stripped so both platforms report the same names.
+$OBJDUMP -d --no-show-raw-insn "$OBJ" | awk '
+    /^[0-9a-f]+ <.*>:$/ {
+        name = $2
+        gsub(/[<>:]/, "", name)
+        sub(/^_/, "", name)
+        current = (name ~ /^(Unit|Raw)Kernel_/) ? name : ""
+        next
+    }
+    current != "" && /^ *[0-9a-f]+:/ { count[current]++ }
+    END {
+        printf "%-28s %8s %8s %8s\n", "kernel", "unit", "raw", "ratio"
+        for (name in count) {
+            if (name !~ /^UnitKernel_/) continue
+            op = substr(name, length("UnitKernel_") + 1)
+            raw = count["RawKernel_" op]
+            if (raw == 0) continue
+            printf "%-28s %8d %8d %7.2fx\n", op, count[name], raw, count[name] / raw
+        }
+    }' | (read -r header; echo "$header"; sort)
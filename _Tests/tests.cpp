@@ -6,13 +6,31 @@
 #include "../UnitLib/VectorMath.h"
 #include "../UnitLib/Matrix.h"
 #include "../UnitLib/Print.h"
+#include "../UnitLib/BatchMath.h"
 
+#include "../PhysicsLib/AABBSet.h"
+#include "../PhysicsLib/AABBTree.h"
 #include "../PhysicsLib/Actor.h"
 #include "../PhysicsLib/Collision.h"
+#include "../PhysicsLib/PhysicsWorld.h"
+#include "../PhysicsLib/SweepAndPrune.h"
+
+#include "../AsciiGraphics.h"
+#include "../AsteroidGame.h"
+#include "../Game.h"
+#include "../HeadlessGame.h"
+#include "../Rng.h"
+#include "../SpatialHash.h"
+#include "../Sprite.h"
+#include "../ThreadPool.h"
+
 #include "AdditiveString.h"
 #include "PrimeField.h"
 
 #include <iomanip>
+#include <sstream>
+#include <span>
+#include <vector>
 
 // ------------------------------------------------------------
 // Testing library utils
@@ -269,6 +287,1470 @@ void TestActorRotationAfterCollision()
     std::cout << "TestActorRotationAfterCollision passed.\n";
 }
 
+void TestAABBTree()
+{
+    AABBTree<int> tree{0.0};
+    Rng rng{7};
+
+    const int n = 300;
+    std::vector<AABB> boxes(n);
+    std::vector<int32_t> proxies(n);
+    for (int i = 0; i < n; i++)
+    {
+        boxes[i] = {rng.Uniform(0, 100), rng.Uniform(0, 100), rng.Uniform(0.1, 4), rng.Uniform(0.1, 4)};
+        proxies[i] = tree.Insert(boxes[i], i);
+    }
+    assert(tree.Validate());
+    assert(tree.Size() == n);
+    assert(tree.Height() <= 20);
+
+    // Region queries match brute force
+    AABB region = {40, 40, 15, 10};
+    std::vector<int> found;
+    tree.Query(region, [&](int32_t proxy)
+               { found.push_back(tree.GetData(proxy)); });
+    std::sort(found.begin(), found.end());
+    std::vector<int> expected;
+    for (int i = 0; i < n; i++)
+    {
+        if (CheckCollision(boxes[i], region))
+        {
+            expected.push_back(i);
+        }
+    }
+    assert(found == expected);
+
+    // Pairs match brute force, each reported once
+    auto CheckPairs = [&]()
+    {
+        std::vector<std::pair<int, int>> pairs;
+        tree.QueryPairs([&](int32_t a, int32_t b)
+                        {
+                            int i = tree.GetData(a);
+                            int j = tree.GetData(b);
+                            pairs.push_back({std::min(i, j), std::max(i, j)}); });
+        std::sort(pairs.begin(), pairs.end());
+        assert(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+
+        std::vector<std::pair<int, int>> bruteForce;
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = i + 1; j < n; j++)
+            {
+                if (proxies[i] != AABB_NULL_NODE && proxies[j] != AABB_NULL_NODE && CheckCollision(boxes[i], boxes[j]))
+                {
+                    bruteForce.push_back({i, j});
+                }
+            }
+        }
+        assert(pairs == bruteForce);
+    };
+    CheckPairs();
+
+    // Remove every third box and move the rest
+    for (int i = 0; i < n; i += 3)
+    {
+        tree.Remove(proxies[i]);
+        proxies[i] = AABB_NULL_NODE;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (proxies[i] != AABB_NULL_NODE)
+        {
+            boxes[i].x += rng.Uniform(-5, 5);
+            boxes[i].y += rng.Uniform(-5, 5);
+            tree.Move(proxies[i], boxes[i]);
+        }
+    }
+    assert(tree.Validate());
+    assert(tree.Size() == n - (n + 2) / 3);
+    CheckPairs();
+
+    // Fat boxes absorb small moves
+    AABBTree<int> fatTree{0.5};
+    int32_t p = fatTree.Insert({0, 0, 1, 1}, 0);
+    assert(!fatTree.Move(p, {0.2, 0.2, 1, 1}));
+    assert(fatTree.Move(p, {3, 0, 1, 1}, {3, 0}));
+    assert(Contains(fatTree.GetFatAABB(p), {3, 0, 1, 1}));
+    assert(fatTree.Validate());
+
+    // Ray casts visit boxes along the segment and can be clipped
+    AABBTree<int> rayTree{0.0};
+    for (int i = 0; i < 10; i++)
+    {
+        rayTree.Insert({i * 10.0, 0, 1, 1}, i);
+    }
+    int hits = 0;
+    rayTree.RayCast({-5, 0.5}, {200, 0.5}, [&](int32_t, double maxFraction)
+                    { hits++; return maxFraction; });
+    assert(hits == 10);
+
+    int nearest = -1;
+    double nearestFraction = 2;
+    rayTree.RayCast({-5, 0.5}, {200, 0.5}, [&](int32_t proxy, double)
+                    {
+                        const AABB &box = rayTree.GetFatAABB(proxy);
+                        double fraction = (box.x + 5) / 205;
+                        if (fraction < nearestFraction)
+                        {
+                            nearestFraction = fraction;
+                            nearest = rayTree.GetData(proxy);
+                        }
+                        return fraction; });
+    assert(nearest == 0);
+
+    int missed = 0;
+    rayTree.RayCast({-5, 5}, {200, 5}, [&](int32_t, double maxFraction)
+                    { missed++; return maxFraction; });
+    assert(missed == 0);
+
+    std::cout << "TestAABBTree passed.\n";
+}
+
+void TestActorIncrementalRotation()
+{
+    Actor<double> exact({0.0, 0.0}, {1.0, 0.5}, 0.3, 0.7);
+    Actor<double> incremental({0.0, 0.0}, {1.0, 0.5}, 0.3, 0.7);
+    incremental.rotationMode = RotationMode::Incremental;
+
+    // Many wraps of the angle at a fixed timestep
+    for (int i = 0; i < 20000; i++)
+    {
+        exact.Update(1.0 / 60);
+        incremental.Update(1.0 / 60);
+    }
+    assert(exact.rotation == incremental.rotation);
+    assert(NearlyEqual(exact.position.x(), incremental.position.x(), 1e-9));
+    assert(NearlyEqual(exact.position.y(), incremental.position.y(), 1e-9));
+
+    // Writing the rotation directly is picked up
+    incremental.rotation = M_PI / 2;
+    incremental.rotationSpeed = 0;
+    incremental.position = {0.0, 0.0};
+    incremental.Update(1.0);
+    assert(NearlyEqual(incremental.position.x(), -0.5));
+    assert(NearlyEqual(incremental.position.y(), 1.0));
+
+    std::cout << "TestActorIncrementalRotation passed.\n";
+}
+
+void TestActorUpdateAll()
+{
+    std::vector<Actor<double>> batch;
+    for (int i = 0; i < 37; i++)
+    {
+        batch.emplace_back(Vector2<double>{i * 1.0, -i * 1.0}, Vector2<double>{1.0, i * 0.1}, i * 0.2, (i % 5) * 0.9 - 1.5);
+        batch.back().rotationMode = i % 2 ? RotationMode::Incremental : RotationMode::Exact;
+    }
+    std::vector<Actor<double>> single = batch;
+
+    for (int step = 0; step < 200; step++)
+    {
+        Actor<double>::UpdateAll(batch, 0.05);
+        for (Actor<double> &actor : single)
+        {
+            actor.Update(0.05);
+        }
+    }
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        assert(batch[i].rotation == single[i].rotation);
+        assert(NearlyEqual(batch[i].position.x(), single[i].position.x(), 1e-9));
+        assert(NearlyEqual(batch[i].position.y(), single[i].position.y(), 1e-9));
+        assert(NearlyEqual(batch[i].boundingBox.x, single[i].boundingBox.x, 1e-9));
+        assert(batch[i].state == ActorState::Moving);
+    }
+
+    std::cout << "TestActorUpdateAll passed.\n";
+}
+
+void TestSweepAABB()
+{
+    AABB box = {0.0, 0.0, 1.0, 1.0};
+    AABB wall = {5.0, -2.0, 0.1, 4.0};
+
+    // Head-on: contact when the right edge reaches the wall
+    TimeOfImpact hit = SweepAABB(box, 10.0, 0.0, wall);
+    assert(hit.hit);
+    assert(NearlyEqual(hit.time, 0.4));
+    assert(hit.normalX == -1.0 && hit.normalY == 0.0);
+
+    // Too short, passing beside, or moving away
+    assert(!SweepAABB(box, 3.0, 0.0, wall).hit);
+    assert(!SweepAABB(box, 10.0, 6.0, wall).hit);
+    assert(!SweepAABB(box, -10.0, 0.0, wall).hit);
+
+    // Diagonal approach hits the top face
+    AABB floor = {-10.0, -5.0, 20.0, 1.0};
+    TimeOfImpact land = SweepAABB(box, 2.0, -8.0, floor);
+    assert(land.hit);
+    assert(NearlyEqual(land.time, 0.5));
+    assert(land.normalX == 0.0 && land.normalY == 1.0);
+
+    // Touching counts when moving in, not when moving out
+    AABB touching = {1.0, 0.0, 1.0, 1.0};
+    assert(SweepAABB(box, 1.0, 0.0, touching).hit);
+    assert(SweepAABB(box, 1.0, 0.0, touching).time == 0.0);
+    assert(!SweepAABB(box, -1.0, 0.0, touching).hit);
+
+    // Boxes that start overlapping are left to the discrete test
+    assert(!SweepAABB(box, 1.0, 0.0, {0.5, 0.5, 1.0, 1.0}).hit);
+
+    std::cout << "TestSweepAABB passed.\n";
+}
+
+void TestActorContinuousCollision()
+{
+    // Moves 10 units per step, far more than the wall is thick
+    std::vector<AABB> solids = {{5.0, -2.0, 0.1, 4.0}};
+
+    Actor<double> discrete({0.0, 0.0}, {100.0, 0.0}, 0.0, 0.0);
+    TimeOfImpact missed = discrete.Update(0.1, solids);
+    assert(!missed.hit);
+    assert(discrete.position.x() > 5.1); // Tunnelled through
+
+    Actor<double> continuous({0.0, 0.0}, {100.0, 0.0}, 0.0, 0.0);
+    continuous.collisionMode = CollisionMode::Continuous;
+    TimeOfImpact hit = continuous.Update(0.1, solids);
+    assert(hit.hit);
+    assert(NearlyEqual(continuous.position.x(), 4.5)); // Right edge resting on the wall
+    assert(continuous.state == ActorState::Colliding);
+    assert(NearlyEqual(continuous.velocity.x(), -80.0));
+
+    // Bounces off instead of sticking to the wall
+    TimeOfImpact next = continuous.Update(0.1, solids);
+    assert(!next.hit);
+    assert(NearlyEqual(continuous.position.x(), -3.5));
+
+    std::cout << "TestActorContinuousCollision passed.\n";
+}
+
+void TestAABBSet()
+{
+    AABBSet set;
+    Rng rng{5};
+
+    // An odd count, so the last block is partly empty
+    const int n = 101;
+    std::vector<AABB> boxes(n);
+    for (int i = 0; i < n; i++)
+    {
+        boxes[i] = {rng.Uniform(0, 40), rng.Uniform(0, 40), rng.Uniform(0.5, 6), rng.Uniform(0.5, 6)};
+        assert(set.Add(boxes[i]) == static_cast<size_t>(i));
+    }
+    assert(set.Size() == n);
+
+    // All pairs match CheckCollision, in order
+    std::vector<std::pair<size_t, size_t>> pairs;
+    set.ForEachPair([&](size_t i, size_t j)
+                    { pairs.push_back({i, j}); });
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = i + 1; j < n; j++)
+        {
+            if (CheckCollision(boxes[i], boxes[j]))
+            {
+                expected.push_back({i, j});
+            }
+        }
+    }
+    assert(!expected.empty());
+    assert(pairs == expected);
+    assert(set.CountPairs() == expected.size());
+
+    // Queries and raw masks match CheckCollision
+    AABB region = {10, 10, 8, 5};
+    std::vector<size_t> found;
+    set.Query(region, [&](size_t i)
+              { found.push_back(i); });
+    std::vector<size_t> expectedFound;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (CheckCollision(region, boxes[i]))
+        {
+            expectedFound.push_back(i);
+        }
+    }
+    assert(found == expectedFound);
+
+    for (size_t first = 0; first < n; first += AABB_SET_BLOCK)
+    {
+        uint32_t mask = set.OverlapMask(region, first);
+        for (size_t k = 0; k < AABB_SET_BLOCK; k++)
+        {
+            bool expectedBit = first + k < n && CheckCollision(region, boxes[first + k]);
+            assert(((mask >> k) & 1) == expectedBit);
+        }
+    }
+
+    // A NaN box overlaps everything, as in CheckCollision, but never the empty lanes
+    AABB nanBox = {std::nan(""), std::nan(""), 1, 1};
+    size_t nanHits = 0;
+    set.Query(nanBox, [&](size_t)
+              { nanHits++; });
+    assert(nanHits == n);
+
+    // Touching boxes overlap; removal moves the last box into the hole
+    AABBSet small;
+    small.Add({0, 0, 1, 1});
+    small.Add({1, 0, 1, 1});
+    small.Add({5, 5, 1, 1});
+    assert(small.CountPairs() == 1);
+    small.RemoveSwap(0);
+    assert(small.Size() == 2);
+    assert(small.Get(0).x == 5);
+    assert(small.CountPairs() == 0);
+
+    std::cout << "TestAABBSet passed.\n";
+}
+
+void TestActorTreeRegistration()
+{
+    AABBTree<Actor<double> *> tree;
+    Actor<double> a({0.0, 0.0}, {1.0, 0.0}, 0.0, 0.0);
+    Actor<double> b({5.0, 0.0}, {-1.0, 0.0}, 0.0, 0.0);
+    a.RegisterBounds(tree);
+    b.RegisterBounds(tree);
+    assert(tree.Size() == 2);
+
+    int contacts = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        a.Update(0.5);
+        b.Update(0.5);
+        a.SyncBounds(tree, 0.5);
+        b.SyncBounds(tree, 0.5);
+        tree.QueryPairs([&](int32_t p1, int32_t p2)
+                        {
+                            if (CheckCollision(tree.GetData(p1)->boundingBox, tree.GetData(p2)->boundingBox))
+                            {
+                                contacts++;
+                            } });
+    }
+    assert(contacts > 0);
+    assert(tree.Validate());
+
+    a.UnregisterBounds(tree);
+    assert(a.proxy == AABB_NULL_NODE);
+    assert(tree.Size() == 1);
+
+    std::cout << "TestActorTreeRegistration passed.\n";
+}
+
+void TestSweepAndPrune()
+{
+    SweepAndPrune<int> sap;
+    Rng rng{11};
+
+    const int n = 200;
+    std::vector<AABB> boxes(n);
+    std::vector<int32_t> proxies(n);
+    for (int i = 0; i < n; i++)
+    {
+        boxes[i] = {rng.Uniform(0, 60), rng.Uniform(0, 60), rng.Uniform(0.5, 4), rng.Uniform(0.5, 4)};
+        proxies[i] = sap.Insert(boxes[i], i);
+    }
+
+    using PairSet = std::vector<std::pair<int, int>>;
+    auto BruteForce = [&]()
+    {
+        PairSet pairs;
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = i + 1; j < n; j++)
+            {
+                if (proxies[i] != SAP_NULL_PROXY && proxies[j] != SAP_NULL_PROXY && CheckCollision(boxes[i], boxes[j]))
+                {
+                    pairs.push_back({i, j});
+                }
+            }
+        }
+        return pairs;
+    };
+    auto ToIndices = [&](const std::vector<SweepAndPrune<int>::Pair> &proxyPairs)
+    {
+        PairSet pairs;
+        for (const auto &[a, b] : proxyPairs)
+        {
+            int i = sap.GetData(a);
+            int j = sap.GetData(b);
+            pairs.push_back({std::min(i, j), std::max(i, j)});
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    // The first update reports every overlap as new
+    sap.Update();
+    PairSet previous = BruteForce();
+    assert(sap.PairCount() == previous.size());
+    assert(ToIndices(sap.GetBegan()) == previous);
+    assert(sap.GetEnded().empty());
+
+    // Small random moves: the pair set tracks brute force, and the events are exactly the difference
+    for (int frame = 0; frame < 50; frame++)
+    {
+        if (frame == 20)
+        {
+            for (int i = 0; i < n; i += 4)
+            {
+                sap.Remove(proxies[i]);
+                proxies[i] = SAP_NULL_PROXY;
+            }
+        }
+        if (frame == 30)
+        {
+            for (int i = 0; i < n; i += 4)
+            {
+                proxies[i] = sap.Insert(boxes[i], i);
+            }
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            if (proxies[i] != SAP_NULL_PROXY)
+            {
+                boxes[i].x += rng.Uniform(-0.5, 0.5);
+                boxes[i].y += rng.Uniform(-0.5, 0.5);
+                sap.Move(proxies[i], boxes[i]);
+            }
+        }
+        sap.Update();
+
+        PairSet current = BruteForce();
+        assert(sap.PairCount() == current.size());
+
+        PairSet began;
+        PairSet ended;
+        std::set_difference(current.begin(), current.end(), previous.begin(), previous.end(), std::back_inserter(began));
+        std::set_difference(previous.begin(), previous.end(), current.begin(), current.end(), std::back_inserter(ended));
+        assert(ToIndices(sap.GetBegan()) == began);
+        if (frame != 20)
+        {
+            assert(ToIndices(sap.GetEnded()) == ended);
+        }
+        else
+        {
+            // Pairs of removed proxies are reported too, but their data is gone
+            assert(sap.GetEnded().size() == ended.size());
+        }
+        previous = current;
+    }
+
+    // Touching boxes overlap, as in CheckCollision
+    SweepAndPrune<int> touching;
+    int32_t a = touching.Insert({0, 0, 1, 1}, 0);
+    int32_t b = touching.Insert({1, 0, 1, 1}, 1);
+    touching.Update();
+    assert(touching.HasPair(a, b));
+    touching.Move(b, {1.5, 0, 1, 1});
+    touching.Update();
+    assert(!touching.HasPair(a, b));
+    assert(touching.GetEnded().size() == 1);
+
+    // A box passing straight through another within one update reports nothing
+    touching.Move(b, {-1.5, 0, 1, 1});
+    touching.Update();
+    assert(touching.GetBegan().empty() && touching.GetEnded().empty());
+
+    std::cout << "TestSweepAndPrune passed.\n";
+}
+
+void TestActorSweepAndPruneContacts()
+{
+    SweepAndPrune<Actor<double> *> sap;
+    Actor<double> a({0.0, 0.0}, {1.0, 0.0}, 0.0, 0.0);
+    Actor<double> b({0.5, 0.0}, {0.0, 0.0}, 0.0, 0.0);
+    a.RegisterBounds(sap);
+    b.RegisterBounds(sap);
+
+    // The actors stay overlapping for several frames, but only the first one is a new contact
+    int collisions = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        a.SyncBounds(sap);
+        b.SyncBounds(sap);
+        sap.Update();
+        Actor<double>::BeginContacts(sap);
+        collisions += a.state == ActorState::Colliding;
+        a.state = ActorState::Moving;
+    }
+    assert(collisions == 1);
+    assert(NearlyEqual(a.velocity.x(), -0.8));
+
+    a.UnregisterBounds(sap);
+    assert(a.proxy == SAP_NULL_PROXY);
+    assert(sap.Size() == 1);
+
+    std::cout << "TestActorSweepAndPruneContacts passed.\n";
+}
+
+void TestUnitTypedActor()
+{
+    using Meter = dAtomic<"meter">;
+    using Second = dAtomic<"second">;
+    using UnitActor = Actor<Meter, Second>;
+    using Speed = UnitActor::Velocity;
+
+    static_assert(std::is_same_v<UnitActor::Scalar, double>);
+    static_assert(std::is_same_v<decltype(Speed{} * Second{}), Meter>);
+    static_assert(sizeof(BasicAABB<Meter>) == sizeof(AABB));
+    static_assert(sizeof(UnitActor) == sizeof(Actor<double>));
+
+    UnitActor typed({Meter{1.0}, Meter{2.0}}, {Speed{1.0}, Speed{0.5}}, 0.3, UnitActor::AngularSpeed{0.7},
+                    {Meter{2.0}, Meter{1.0}});
+    Actor<double> plain({1.0, 2.0}, {1.0, 0.5}, 0.3, 0.7, {2.0, 1.0});
+    for (int i = 0; i < 100; i++)
+    {
+        typed.Update(Second{1.0 / 60});
+        plain.Update(1.0 / 60);
+    }
+    assert(typed.rotation == plain.rotation);
+    assert(typed.position.x().GetValue() == plain.position.x());
+    assert(typed.position.y().GetValue() == plain.position.y());
+    assert(typed.boundingBox.width.GetValue() == 2.0);
+    assert(ToRawAABB(typed.boundingBox).x == plain.boundingBox.x);
+
+    BasicAABB<Meter> a = {Meter{0.0}, Meter{0.0}, Meter{1.0}, Meter{1.0}};
+    BasicAABB<Meter> b = {Meter{1.0}, Meter{0.5}, Meter{1.0}, Meter{1.0}};
+    BasicAABB<Meter> c = {Meter{1.5}, Meter{0.0}, Meter{1.0}, Meter{1.0}};
+    assert(CheckCollision(a, b));
+    assert(!CheckCollision(a, c));
+
+    // Continuous mode takes unit-typed solids
+    UnitActor mover({Meter{0.0}, Meter{0.0}}, {Speed{10.0}, Speed{0.0}}, 0.0, UnitActor::AngularSpeed{0.0});
+    mover.collisionMode = CollisionMode::Continuous;
+    std::vector<BasicAABB<Meter>> walls = {{Meter{3.0}, Meter{-1.0}, Meter{1.0}, Meter{2.0}}};
+    TimeOfImpact hit = mover.Update(Second{1.0}, walls);
+    assert(hit.hit);
+    assert(NearlyEqual(mover.position.x().GetValue(), 2.5));
+
+    std::cout << "TestUnitTypedActor passed.\n";
+}
+
+void TestPhysicsWorld()
+{
+    // Pairs of actors flying at each other, some spinning, across several integrate slices
+    auto Run = [](ThreadPool *pool, std::vector<CollisionEvent> &events)
+    {
+        PhysicsWorld<double> world{pool};
+        for (int i = 0; i < 3000; i++)
+        {
+            double direction = i % 2 == 0 ? 1.0 : -1.0;
+            world.Add(Actor<double>({i * 3.0, (i / 2) * 0.25}, {direction, 0.0}, 0.0, (i % 5 == 0) * 0.05));
+        }
+        for (int step = 0; step < 30; step++)
+        {
+            world.Step(0.1);
+            const std::vector<CollisionEvent> &stepEvents = world.GetEvents();
+            assert(std::is_sorted(stepEvents.begin(), stepEvents.end(), [](const CollisionEvent &x, const CollisionEvent &y)
+                                  { return x.a != y.a ? x.a < y.a : x.b < y.b; }));
+            events.insert(events.end(), stepEvents.begin(), stepEvents.end());
+        }
+        return std::vector<Actor<double>>(world.GetActors().begin(), world.GetActors().end());
+    };
+
+    std::vector<CollisionEvent> serialEvents;
+    std::vector<Actor<double>> serial = Run(nullptr, serialEvents);
+    assert(serialEvents.size() >= 1000);
+    for (const CollisionEvent &event : serialEvents)
+    {
+        assert(event.a < event.b);
+        assert(event.depth >= 0);
+    }
+
+    for (size_t threads : {1, 4})
+    {
+        ThreadPool pool{threads};
+        std::vector<CollisionEvent> events;
+        std::vector<Actor<double>> parallel = Run(&pool, events);
+        assert(events.size() == serialEvents.size());
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            assert(events[i].a == serialEvents[i].a && events[i].b == serialEvents[i].b);
+            assert(events[i].depth == serialEvents[i].depth);
+        }
+        for (size_t i = 0; i < parallel.size(); i++)
+        {
+            assert(parallel[i].position.x() == serial[i].position.x());
+            assert(parallel[i].position.y() == serial[i].position.y());
+            assert(parallel[i].rotation == serial[i].rotation);
+        }
+    }
+
+    // Head-on pair: one event, both rebound, and dispatch sees the actors
+    PhysicsWorld<double> world;
+    world.Add(Actor<double>({0.0, 0.0}, {1.0, 0.0}, 0.0, 0.0));
+    world.Add(Actor<double>({1.5, 0.0}, {-1.0, 0.0}, 0.0, 0.0));
+    world.Step(0.5);
+    assert(world.GetEvents().size() == 1);
+    assert(world.GetEvents()[0].normalX == 1.0);
+    assert(NearlyEqual(world.Get(0).velocity.x(), -0.8));
+    assert(NearlyEqual(world.Get(1).velocity.x(), 0.8));
+    int dispatched = 0;
+    world.DispatchEvents([&](const CollisionEvent &, Actor<double> &a, Actor<double> &b)
+                         {
+                             dispatched++;
+                             assert(a.state == ActorState::Colliding && b.state == ActorState::Colliding); });
+    assert(dispatched == 1);
+
+    // Still touching on the next step: not a new contact
+    world.Step(0.01);
+    assert(world.GetEvents().empty());
+
+    // The middle actor is hit from both sides in one step: two events, but it rebounds once
+    PhysicsWorld<double> three;
+    three.Add(Actor<double>({-1.2, 0.0}, {1.0, 0.0}, 0.0, 0.0));
+    three.Add(Actor<double>({0.0, 0.0}, {0.1, 0.0}, 0.0, 0.0));
+    three.Add(Actor<double>({1.2, 0.0}, {-1.0, 0.0}, 0.0, 0.0));
+    three.Step(0.5);
+    assert(three.GetEvents().size() == 2);
+    assert(NearlyEqual(three.Get(0).velocity.x(), -0.8));
+    assert(NearlyEqual(three.Get(1).velocity.x(), -0.08));
+    assert(NearlyEqual(three.Get(2).velocity.x(), 0.8));
+
+    std::cout << "TestPhysicsWorld passed.\n";
+}
+
+/** @brief Minimal entity for pool tests; counts live instances */
+struct CountedEntity : public Entity
+{
+    inline static int live = 0;
+    int id;
+
+    explicit CountedEntity(int id_) : id{id_}
+    {
+        live++;
+    }
+    ~CountedEntity()
+    {
+        live--;
+    }
+    inline void Update() override {}
+    inline void Draw() override {}
+};
+
+struct ThrowingEntity : public Entity
+{
+    ThrowingEntity()
+    {
+        throw std::runtime_error("constructor failed");
+    }
+    inline void Update() override {}
+    inline void Draw() override {}
+};
+
+void TestEntityPool()
+{
+    {
+        EntityPool<Entity, 8> pool;
+        CountedEntity *a = pool.Create<CountedEntity>(0);
+        CountedEntity *b = pool.Create<CountedEntity>(1);
+        CountedEntity *c = pool.Create<CountedEntity>(2);
+        Handle staleA = a->GetHandle();
+        Handle handleB = b->GetHandle();
+        Handle handleC = c->GetHandle();
+
+        // A destroyed handle is rejected, and destroying it again does nothing
+        pool.Destroy(staleA);
+        assert(!pool.IsValid(staleA));
+        assert(pool.Get(staleA) == nullptr);
+        assert(CountedEntity::live == 2);
+        pool.Destroy(staleA);
+        assert(pool.Size() == 2 && CountedEntity::live == 2);
+
+        // The slot is reused under a new generation; the old handle stays stale
+        CountedEntity *d = pool.Create<CountedEntity>(3);
+        assert(d->GetHandle().index == staleA.index);
+        assert(d->GetHandle().generation == staleA.generation + 1);
+        assert(pool.Get(staleA) == nullptr);
+        assert(pool.Get<CountedEntity>(d->GetHandle()) == d);
+
+        // Swap-remove moved the last object into the hole: iteration sees each live object once
+        // and every handle still resolves to its own object
+        pool.Destroy(handleB);
+        int seen = 0;
+        for (Entity *entity : pool)
+        {
+            seen |= 1 << static_cast<CountedEntity *>(entity)->id;
+            assert(pool.Get(entity->GetHandle()) == entity);
+        }
+        assert(seen == ((1 << 2) | (1 << 3)));
+        assert(pool.Get<CountedEntity>(handleC) == c);
+
+        // A throwing constructor gives its slot back: the next object takes it, and capacity is not lost
+        bool caught = false;
+        try
+        {
+            pool.Create<ThrowingEntity>();
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        assert(caught);
+        assert(pool.Size() == 2);
+        Handle reused = pool.Create<CountedEntity>(4)->GetHandle();
+        assert(reused.index == handleB.index);
+        assert(reused.generation == handleB.generation + 2);
+
+        while (pool.Size() < 8)
+        {
+            pool.Create<CountedEntity>(5);
+        }
+        caught = false;
+        try
+        {
+            pool.Create<CountedEntity>(6);
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        assert(caught);
+        assert(CountedEntity::live == 8);
+    }
+    assert(CountedEntity::live == 0);
+
+    std::cout << "TestEntityPool passed.\n";
+}
+
+/** @brief Game object that records its updates, for checking child order and ownership */
+template <size_t Depth>
+struct TracedObject : public GameObject<Depth>
+{
+    inline static std::vector<int> updates;
+    inline static int live = 0;
+    int id;
+
+    explicit TracedObject(int id_) : id{id_}
+    {
+        live++;
+    }
+    ~TracedObject()
+    {
+        live--;
+    }
+    inline void Update() override
+    {
+        updates.push_back(id);
+        GameObject<Depth>::Update();
+    }
+    inline void Draw() override {}
+};
+
+void TestChildList()
+{
+    {
+        TracedObject<0> parent{0};
+        auto *first = parent.AddChild<TracedObject>(1);
+        parent.AddChild<TracedObject>(2);
+        first->AddChild<TracedObject>(11);
+        parent.AddChild<TracedObject>(3);
+        assert(first->GetParent() == &parent);
+        assert(TracedObject<1>::live == 3 && TracedObject<2>::live == 1);
+
+        // Children update in the order they were added, depth first
+        parent.Update();
+        assert(TracedObject<0>::updates == std::vector<int>{0});
+        assert((TracedObject<1>::updates == std::vector<int>{1, 2, 3}));
+        assert(TracedObject<2>::updates == std::vector<int>{11});
+
+        // At most MAX_CHILDREN per parent; the rejected one is never constructed
+        while (TracedObject<1>::live < static_cast<int>(MAX_CHILDREN))
+        {
+            parent.AddChild<TracedObject>(4);
+        }
+        bool caught = false;
+        try
+        {
+            parent.AddChild<TracedObject>(5);
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        assert(caught);
+        assert(TracedObject<1>::live == static_cast<int>(MAX_CHILDREN));
+    }
+
+    // The parent deletes every child, and grandchild, exactly once
+    assert(TracedObject<0>::live == 0);
+    assert(TracedObject<1>::live == 0);
+    assert(TracedObject<2>::live == 0);
+
+    std::cout << "TestChildList passed.\n";
+}
+
+void TestKinematicBodyRelease()
+{
+    KinematicStore<kWrapNone> store;
+    KinematicBody<kWrapNone> parked{store, {5, 5}};
+    KinematicBody<kWrapNone> moving{store, {1, 1}};
+    moving.SetVel({1, 0});
+    parked.SetVel({1, 0});
+
+    store.Integrate(1_frame);
+    parked.Release();
+    assert(parked.IsReleased() && !moving.IsReleased());
+    assert(store.Size() == 1);
+
+    // The surviving entry was swapped into place and still integrates
+    store.Integrate(1_frame);
+    assert(moving.GetPos().x() == Worldspace{3});
+
+    // Releasing twice, then destroying, leaves the store alone
+    parked.Release();
+    assert(store.Size() == 1);
+
+    std::cout << "TestKinematicBodyRelease passed.\n";
+}
+
+/** @brief Time source for GameLoop tests: time only moves when the test sets it, and sleeps return at once */
+struct FakeTimeSource
+{
+    using Clock = std::chrono::steady_clock;
+
+    inline static Clock::time_point now{};
+
+    inline static Clock::time_point Now()
+    {
+        return now;
+    }
+
+    inline static void SleepUntil(Clock::time_point) {}
+};
+
+void TestGameLoop()
+{
+    using namespace std::chrono_literals;
+    BasicGameLoop<FakeTimeSource> loop{10ms, 10ms, 5};
+
+    int updates = 0;
+    double alpha = -1;
+    auto Frame = [&](std::chrono::milliseconds at)
+    {
+        FakeTimeSource::now = FakeTimeSource::Clock::time_point{at};
+        int before = updates;
+        loop.Tick([&]()
+                  { updates++; }, [&](double a)
+                  { alpha = a; });
+        return updates - before;
+    };
+
+    // The first frame runs exactly one update
+    assert(Frame(0ms) == 1);
+    assert(alpha == 0);
+
+    // 25 ms: two steps, with half a step left over
+    assert(Frame(25ms) == 2);
+    assert(NearlyEqual(alpha, 0.5));
+
+    // 4 ms more: not enough for a step, so only alpha moves
+    assert(Frame(29ms) == 0);
+    assert(NearlyEqual(alpha, 0.9));
+
+    // A 100 ms stall: capped at 5 updates, the rest dropped, the fraction kept
+    assert(Frame(129ms) == 5);
+    assert(loop.GetStats().droppedUpdates == 5);
+    assert(NearlyEqual(alpha, 0.9));
+    assert(loop.GetStats().lastFrameUpdates == 5);
+
+    // After a reset the time spent paused is forgotten
+    loop.Reset();
+    assert(Frame(1000ms) == 1);
+    assert(alpha == 0);
+
+    assert(loop.GetStats().frames == 5);
+    assert(loop.GetStats().updates == 9);
+    assert(NearlyEqual(loop.GetStats().maxFrameMs, 100));
+
+    std::cout << "TestGameLoop passed.\n";
+}
+
+void TestThreadPool()
+{
+    ThreadPool pool{4};
+
+    // Every index runs exactly once
+    std::vector<std::atomic<int>> hits(1000);
+    pool.ParallelFor(hits.size(), [&](size_t i)
+                     { hits[i]++; });
+    for (const std::atomic<int> &hit : hits)
+    {
+        assert(hit == 1);
+    }
+
+    // Nested: tasks run their own ParallelFor on the same pool, and help instead of deadlocking
+    std::atomic<int> inner{0};
+    pool.ParallelFor(16, [&](size_t)
+                     { pool.ParallelFor(100, [&](size_t)
+                                        { inner++; }); });
+    assert(inner == 1600);
+
+    // A throwing call: the exception reaches the caller only after every call has finished
+    std::atomic<int> finished{0};
+    bool caught = false;
+    try
+    {
+        pool.ParallelFor(100, [&](size_t i)
+                         {
+                             finished++;
+                             if (i % 10 == 3)
+                             {
+                                 throw std::runtime_error("task failed");
+                             } });
+    }
+    catch (const std::runtime_error &e)
+    {
+        caught = std::string(e.what()) == "task failed";
+    }
+    assert(caught);
+    assert(finished == 100);
+
+    // Still usable afterwards
+    std::atomic<int> after{0};
+    pool.ParallelFor(10, [&](size_t)
+                     { after++; });
+    assert(after == 10);
+
+    // Tasks submitted from inside tasks, and from outside, all run before the pool is destroyed
+    std::atomic<int> submitted{0};
+    {
+        ThreadPool scoped{3};
+        for (int i = 0; i < 50; i++)
+        {
+            scoped.Submit([&]()
+                          {
+                              for (int j = 0; j < 20; j++)
+                              {
+                                  scoped.Submit([&]()
+                                                { submitted++; });
+                              } });
+        }
+    }
+    assert(submitted == 1000);
+
+    std::cout << "TestThreadPool passed.\n";
+}
+
+void TestRunBatchDeterminism()
+{
+    struct WorldResult
+    {
+        double points;
+        double playerX, playerY;
+        double asteroidX, asteroidY;
+        bool gameOver;
+
+        bool operator==(const WorldResult &) const = default;
+    };
+    auto Run = [](size_t threads)
+    {
+        ThreadPool pool{threads};
+        std::vector<WorldResult> results(8);
+        RunBatch<AsteroidGame>(pool, results.size(), 300, [&](size_t i, AsteroidGame &game)
+                               {
+                                   Vector2<Worldspace> player = game.player->GetPos();
+                                   Vector2<Worldspace> asteroid = game.asteroid->GetPos();
+                                   results[i] = {game.points, player.x().GetValue(), player.y().GetValue(),
+                                                 asteroid.x().GetValue(), asteroid.y().GetValue(), game.gameOver}; });
+        return results;
+    };
+
+    // World i is seeded with seed + i, whichever thread runs it
+    std::vector<WorldResult> serial = Run(1);
+    std::vector<WorldResult> parallel = Run(4);
+    assert(serial == parallel);
+
+    // ...and different seeds really do give different worlds
+    assert(!(serial[0] == serial[1]));
+
+    std::cout << "TestRunBatchDeterminism passed.\n";
+}
+
+void TestRng()
+{
+    // Reference xoshiro256** output for seed 1234567, seeded through splitmix64
+    Rng rng{1234567};
+    const uint64_t expected[] = {3504822795582309479ULL, 1819558768956484042ULL, 1250851346055027673ULL,
+                                 16940231675099994102ULL};
+    for (uint64_t value : expected)
+    {
+        assert(rng.Next() == value);
+    }
+
+    // Fill gives exactly the values of the same number of Uniform calls, and leaves the same state
+    Rng a{42};
+    Rng b{42};
+    std::vector<double> filled(1001);
+    a.Fill(filled, -0.2, 0.2);
+    for (double value : filled)
+    {
+        assert(value == b.Uniform(-0.2, 0.2));
+        assert(value >= -0.2 && value < 0.2);
+    }
+    assert(a == b);
+    assert(a.Next() == b.Next());
+
+    // Values that would round up to hi are kept below it
+    double largest = std::nextafter(1.0, 0.0);
+    assert(1.0 + largest * (2.0 - 1.0) == 2.0);
+    assert(Rng::ToRange(largest, 1.0, 2.0) < 2.0);
+    assert(Rng::ToRange(0.5, 3.0, 3.0) == 3.0);
+
+    std::cout << "TestRng passed.\n";
+}
+
+/** @brief Brute-force box overlap along one axis, trying the wrapped copies of `b` if the axis wraps */
+bool OverlapsOnAxis(double a, double ha, double b, double hb, bool wraps, double width)
+{
+    for (int k = wraps ? -3 : 0; k <= (wraps ? 3 : 0); k++)
+    {
+        if (std::abs(b + k * width - a) <= ha + hb)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <WrapType Wrap>
+void TestSpatialHashAgainstBruteForce()
+{
+    // Odd bounds with a non-zero origin, and a cell size that does not divide the world
+    WorldScope scope{WorldBounds{1, 51, 1, 26}};
+    const double width = XBounds::width();
+    const double height = YBounds::height();
+
+    struct Box
+    {
+        double cx, cy, hx, hy;
+    };
+    auto Overlaps = [&](const Box &a, const Box &b)
+    {
+        return OverlapsOnAxis(a.cx, a.hx, b.cx, b.hx, WrapsX(Wrap), width) &&
+               OverlapsOnAxis(a.cy, a.hy, b.cy, b.hy, WrapsY(Wrap), height);
+    };
+
+    Rng rng{7 + Wrap};
+    auto RandomBox = [&]()
+    {
+        // Mostly small boxes, some near or across the edges, a few larger than the world
+        double scale = rng.Uniform(0, 1) < 0.1 ? 40 : 4;
+        return Box{rng.Uniform(-4, 55), rng.Uniform(-4, 30), rng.Uniform(0, scale), rng.Uniform(0, scale)};
+    };
+
+    for (int round = 0; round < 20; round++)
+    {
+        SpatialHash<Wrap> hash{Worldspace{4}};
+        std::vector<Box> boxes;
+        for (int i = 0; i < 200; i++)
+        {
+            boxes.push_back(RandomBox());
+        }
+        // Straddling the seams and the corner
+        boxes.push_back({1.5, 13, 2, 1});
+        boxes.push_back({50.5, 13, 2, 1});
+        boxes.push_back({25, 1.2, 1, 2});
+        boxes.push_back({25, 25.9, 1, 2});
+        boxes.push_back({50.9, 25.9, 1, 1});
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            const Box &box = boxes[i];
+            hash.Insert(Handle{static_cast<uint32_t>(i), 0}, {box.cx, box.cy}, {box.hx, box.hy});
+        }
+
+        // Pairs
+        std::vector<std::pair<uint32_t, uint32_t>> expectedPairs;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            for (uint32_t j = i + 1; j < boxes.size(); j++)
+            {
+                if (Overlaps(boxes[i], boxes[j]))
+                {
+                    expectedPairs.push_back({i, j});
+                }
+            }
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> foundPairs;
+        for (const auto &[a, b] : hash.FindPairs())
+        {
+            foundPairs.push_back({a.index, b.index});
+        }
+        std::sort(foundPairs.begin(), foundPairs.end());
+        assert(foundPairs == expectedPairs);
+
+        // Box and point queries, each result reported once
+        for (int q = 0; q < 100; q++)
+        {
+            Box probe = RandomBox();
+            if (q % 2 == 0)
+            {
+                probe.hx = probe.hy = 0;
+            }
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < boxes.size(); i++)
+            {
+                if (Overlaps(boxes[i], probe))
+                {
+                    expected.push_back(i);
+                }
+            }
+
+            std::vector<uint32_t> found;
+            auto Collect = [&](Handle handle)
+            { found.push_back(handle.index); };
+            if (q % 2 == 0)
+            {
+                hash.QueryPoint({probe.cx, probe.cy}, Collect);
+            }
+            else
+            {
+                hash.Query({probe.cx, probe.cy}, {probe.hx, probe.hy}, Collect);
+            }
+            std::sort(found.begin(), found.end());
+            assert(found == expected);
+        }
+    }
+
+    // Degenerate input: huge extents cover everything, NaN touches nothing, neither hangs or overflows
+    SpatialHash<Wrap> hash{Worldspace{4}};
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    hash.Insert(Handle{0, 0}, {25, 13}, {1e300, 1e300});
+    hash.Insert(Handle{1, 0}, {nan, 13}, {1, 1});
+    hash.Insert(Handle{2, 0}, {25, 13}, {nan, 1});
+    hash.Insert(Handle{3, 0}, {1e300, -1e300}, {1, 1});
+    int hits = 0;
+    hash.QueryPoint({10, 10}, [&](Handle handle)
+                    { hits++;
+                      assert(handle.index == 0); });
+    assert(hits == 1);
+    hits = 0;
+    hash.Query({25, 13}, {std::numeric_limits<double>::infinity(), 1}, [&](Handle)
+               { hits++; });
+    assert(hits >= 1);
+    for (const auto &[a, b] : hash.FindPairs())
+    {
+        assert(a.index != 1 && a.index != 2 && b.index != 1 && b.index != 2);
+    }
+}
+
+void TestSpatialHash()
+{
+    TestSpatialHashAgainstBruteForce<kWrapNone>();
+    TestSpatialHashAgainstBruteForce<kWrapX>();
+    TestSpatialHashAgainstBruteForce<kWrapY>();
+    TestSpatialHashAgainstBruteForce<kWrapBoth>();
+
+    std::cout << "TestSpatialHash passed.\n";
+}
+
+void TestSpriteStampAcrossSeam()
+{
+    // The default ASCII world: columns 1-50 and rows 1-25, wrapping both ways
+    WorldScope scope{WorldBounds{1, 51, 1, 26}};
+    auto Wrap = [](double v, double lower, double width)
+    { return v - width * std::floor((v - lower) / width); };
+
+    struct Case
+    {
+        double x, y, radius;
+    };
+    // Across the left seam, the right seam, the bottom seam, and a corner, with fractional centers
+    for (const Case &c : {Case{2, 12, 3.5}, Case{49.7, 12.2, 2.75}, Case{25, 25.5, 3}, Case{1.6, 1.4, 4.25}})
+    {
+        NullOStream null;
+        AsciiGraphics ascii{null};
+        const Sprite &sprite = SpriteCache::Circle(c.radius);
+        DrawSprite<kWrapBoth>(ascii, sprite, WorldX<kWrapBoth>{c.x}, WorldY<kWrapBoth>{c.y}, 'o');
+
+        // Brute force: every whole-cell offset within the radius, wrapped into the world on its own
+        std::vector<bool> expected(50 * 25, false);
+        int r = static_cast<int>(c.radius);
+        for (int dy = -r; dy <= r; dy++)
+        {
+            for (int dx = -r; dx <= r; dx++)
+            {
+                if (dx * dx + dy * dy <= c.radius * c.radius)
+                {
+                    int col = static_cast<int>(Wrap(c.x + dx, 1, 50));
+                    int row = static_cast<int>(Wrap(c.y + dy, 1, 25));
+                    expected[(row - 1) * 50 + (col - 1)] = true;
+                }
+            }
+        }
+
+        size_t drawn = 0;
+        for (uint row = 1; row <= 25; row++)
+        {
+            for (uint col = 1; col <= 50; col++)
+            {
+                bool filled = ascii.GetCell(col, row).glyph == 'o';
+                assert(filled == expected[(row - 1) * 50 + (col - 1)]);
+                drawn += filled;
+            }
+        }
+        assert(drawn == sprite.cells);
+        // Nothing spills past the world
+        assert(ascii.GetCell(51, 12).glyph == ' ' && ascii.GetCell(25, 26).glyph == ' ');
+    }
+
+    // Degenerate radii: non-finite is empty, huge is capped, nothing is allocated for them
+    assert(SpriteCache::Circle(std::numeric_limits<double>::infinity()).cells == 0);
+    assert(SpriteCache::Circle(std::numeric_limits<double>::quiet_NaN()).cells == 0);
+    assert(&SpriteCache::Circle(1e300) == &SpriteCache::Circle(SPRITE_MAX_RADIUS));
+    assert(SpriteCache::Circle(0).cells == 1);
+
+    std::cout << "TestSpriteStampAcrossSeam passed.\n";
+}
+
+/**
+ * @brief Minimal terminal for replaying AsciiGraphics output: applies glyphs,
+ * CUP/CUF, ED 2 and SGR to a grid of cells, with wide glyphs covering two
+ * columns. Anything else fails the test.
+ */
+struct ReplayTerminal
+{
+    static constexpr uint COLS = 100;
+    static constexpr uint ROWS = 40;
+
+    std::vector<Cell> cells = std::vector<Cell>(COLS * ROWS);
+    TextStyle style{};
+    uint row = 0;
+    uint col = 0;
+
+    inline void Feed(const std::string &bytes)
+    {
+        size_t i = 0;
+        while (i < bytes.size())
+        {
+            if (bytes[i] == '\033')
+            {
+                assert(i + 1 < bytes.size() && bytes[i + 1] == '[');
+                size_t end = bytes.find_first_of("mHJC", i + 2);
+                assert(end != std::string::npos);
+                Escape_(bytes.substr(i + 2, end - i - 2), bytes[end]);
+                i = end + 1;
+                continue;
+            }
+
+            unsigned char lead = static_cast<unsigned char>(bytes[i]);
+            size_t len = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+            uint32_t glyph = 0;
+            uint32_t cp = len == 1 ? lead : lead & (0x3F >> (len - 1));
+            for (size_t k = 0; k < len; k++)
+            {
+                unsigned char byte = static_cast<unsigned char>(bytes[i + k]);
+                glyph |= static_cast<uint32_t>(byte) << (8 * k);
+                cp = k > 0 ? (cp << 6) | (byte & 0x3F) : cp;
+            }
+            // Only the wide glyphs the test draws
+            Print_(glyph, cp >= 0x4E00 ? 2 : 1);
+            i += len;
+        }
+    }
+
+    inline const Cell &At(uint r, uint c) const
+    {
+        return cells[r * COLS + c];
+    }
+
+private:
+    inline void Escape_(const std::string &params, char op)
+    {
+        std::vector<int> args;
+        std::stringstream ss{params};
+        std::string arg;
+        while (std::getline(ss, arg, ';'))
+        {
+            args.push_back(arg.empty() ? -1 : std::stoi(arg));
+        }
+        auto Arg = [&](size_t k, int fallback)
+        { return k < args.size() && args[k] >= 0 ? args[k] : fallback; };
+
+        switch (op)
+        {
+        case 'H':
+            row = Arg(0, 1) - 1;
+            col = Arg(1, 1) - 1;
+            break;
+        case 'C':
+            col += Arg(0, 1);
+            break;
+        case 'J':
+            assert(Arg(0, 0) == 2);
+            std::fill(cells.begin(), cells.end(), Cell{' ', style, 1});
+            break;
+        case 'm':
+            if (args.empty())
+            {
+                args.push_back(0);
+            }
+            for (int a : args)
+            {
+                if (a <= 0)
+                {
+                    style = TextStyle{};
+                }
+                else if (a == 1 || a == 4 || a == 7)
+                {
+                    style.attribute = static_cast<int8_t>(a);
+                }
+                else if (a == 22 || a == 24 || a == 27)
+                {
+                    // 22 ends bold, 24 underline and 27 reverse
+                    assert(style.attribute == (a == 22 ? kTextBold : a - 20));
+                    style.attribute = kTextNormal;
+                }
+                else if (a >= 30 && a <= 37)
+                {
+                    style.fg = static_cast<int8_t>(a);
+                }
+                else if (a == 39)
+                {
+                    style.fg = kFGDefault;
+                }
+                else if (a >= 40 && a <= 47)
+                {
+                    style.bg = static_cast<int8_t>(a);
+                }
+                else if (a == 49)
+                {
+                    style.bg = kBGNone;
+                }
+                else
+                {
+                    assert(false);
+                }
+            }
+            break;
+        }
+    }
+
+    inline void Print_(uint32_t glyph, uint8_t width)
+    {
+        assert(row < ROWS && col + width <= COLS);
+        Cell *line = &cells[row * COLS];
+        for (uint c = col; c < col + width; c++)
+        {
+            if (line[c].IsContinuation() && c > 0)
+            {
+                line[c - 1] = Cell{' ', line[c - 1].style};
+            }
+            if (line[c].width == 2 && c + 1 < COLS)
+            {
+                line[c + 1] = Cell{' ', line[c].style};
+            }
+        }
+        line[col] = Cell{glyph, style, width};
+        if (width == 2)
+        {
+            line[col + 1] = Cell{0, style, 0};
+        }
+        col += width;
+    }
+};
+
+void TestAsciiGraphicsReplay()
+{
+    const FGColor fgs[] = {kFGDefault, kFGRed, kFGGreen, kFGYellow, kFGCyan};
+    const BGColor bgs[] = {kBGNone, kBGBlack, kBGYellow};
+    const TextAttribute attributes[] = {kTextNormal, kTextBold, kTextUnderline, kTextReverse};
+    const char *texts[] = {"score", "字", "a字b", "🐥", "🐥🐥", "x"};
+
+    // A frame is a list of draw calls; each frame mutates a few of them, like objects moving
+    struct Op
+    {
+        int kind;
+        uint x, y, length;
+        char fill;
+        const char *text;
+        TextStyle style;
+    };
+
+    for (uint64_t seed : {1, 2, 3})
+    {
+        Rng rng{seed};
+        auto Pick = [&](size_t n)
+        { return static_cast<size_t>(rng.Next() % n); };
+        auto RandomOp = [&]()
+        {
+            TextStyle style{static_cast<int8_t>(attributes[Pick(4)]), static_cast<int8_t>(fgs[Pick(5)]),
+                            static_cast<int8_t>(bgs[Pick(3)])};
+            return Op{static_cast<int>(Pick(4)), static_cast<uint>(1 + Pick(50)), static_cast<uint>(1 + Pick(25)),
+                      static_cast<uint>(1 + Pick(12)), "#.*o"[Pick(4)], texts[Pick(6)], style};
+        };
+
+        std::ostringstream stream;
+        AsciiGraphics ascii{stream};
+        ReplayTerminal terminal;
+        std::vector<Op> ops(40);
+        for (Op &op : ops)
+        {
+            op = RandomOp();
+        }
+
+        for (int frame = 0; frame < 300; frame++)
+        {
+            for (size_t k = Pick(4); k > 0; k--)
+            {
+                ops[Pick(ops.size())] = RandomOp();
+            }
+            if (frame % 97 == 50)
+            {
+                ascii.Invalidate();
+            }
+
+            ascii.ClearScreen();
+            ascii.DrawRect(1, 1, 50, 25, '.', false);
+            for (const Op &op : ops)
+            {
+                ascii.SetTextColor(static_cast<FGColor>(op.style.fg), static_cast<BGColor>(op.style.bg),
+                                   static_cast<TextAttribute>(op.style.attribute));
+                switch (op.kind)
+                {
+                case 0:
+                    ascii.DrawChar(op.x, op.y, op.fill);
+                    break;
+                case 1:
+                    ascii.DrawSpan(op.x, op.y, op.length, op.fill);
+                    break;
+                case 2:
+                    ascii.DrawRect(op.x, op.y, op.length, 3, op.fill, op.length % 2 == 0);
+                    break;
+                default:
+                    ascii.DrawText(Worldspace{static_cast<double>(op.x)}, Worldspace{static_cast<double>(op.y)}, op.text);
+                    break;
+                }
+            }
+            ascii.ResetTextColor();
+
+            stream.str("");
+            ascii.EndFrame();
+            terminal.Feed(stream.str());
+            assert(ascii.GetRenderStats().lastFrameBytes == stream.str().size());
+
+            for (uint r = 0; r < ReplayTerminal::ROWS; r++)
+            {
+                for (uint c = 0; c < ReplayTerminal::COLS; c++)
+                {
+                    assert(terminal.At(r, c) == ascii.GetCell(c + 1, r + 1));
+                }
+            }
+            assert(terminal.row == 0 && terminal.col == 0);
+        }
+
+        // Nothing changed: nothing is sent
+        stream.str("");
+        ascii.EndFrame();
+        assert(stream.str().empty());
+    }
+
+    std::cout << "TestAsciiGraphicsReplay passed.\n";
+}
+
 int main()
 {
     // ------------------------------------------------------------
@@ -407,6 +1889,42 @@ int main()
     using Z7Unit_Double = UnitMultRatio<Z7Unit, std::ratio<2>>;
     using Z7Unit_Half = UnitMultRatio<Z7Unit, std::ratio<1, 2>>;
 
+    // /** -- UnitIdentifier canonicalization */
+    std::cout << "Running unit identifier canonicalization tests" << std::endl;
+    {
+        using M1 = UnitBase<"meter", std::ratio<1>>;
+        using S1 = UnitBase<"second", std::ratio<1>>;
+        using K1 = UnitBase<"kelvin", std::ratio<1>>;
+
+        // Leaves are sorted by symbol
+        static_assert((std::is_same_v<MakeUnitIdentifier<S1, M1, K1>, UnitLeafVector<K1, M1, S1>>));
+        static_assert((std::is_same_v<ULSort<UnitLeafVector<S1, M1, S1>>, UnitLeafVector<M1, S1, S1>>));
+
+        // Repeated symbols are merged and exponents reduced
+        static_assert((std::is_same_v<MakeUnitIdentifier<M1, S1, M1, UnitBase<"meter", std::ratio<1, 2>>>,
+                                      UnitLeafVector<UnitBase<"meter", std::ratio<5, 2>>, S1>>));
+        static_assert((std::is_same_v<ULMerge<UnitLeafVector<M1, M1, S1, M1>>,
+                                      UnitLeafVector<UnitBase<"meter", std::ratio<2>>, S1, M1>>));
+
+        // Zero exponents are removed, including after merging
+        static_assert((std::is_same_v<MakeUnitIdentifier<M1, S1, UnitBase<"meter", std::ratio<-1>>>, UnitLeafVector<S1>>));
+        static_assert((std::is_same_v<MakeUnitIdentifier<UnitBase<"meter", std::ratio<0>>>, EmptyUid>));
+        static_assert((std::is_same_v<MakeUnitIdentifier<>, EmptyUid>));
+
+        // Symbols that share a prefix are still distinct
+        using Me = UnitBase<"me", std::ratio<1>>;
+        static_assert((std::is_same_v<MakeUnitIdentifier<M1, Me>, UnitLeafVector<Me, M1>>));
+
+        // Identifier transforms
+        using MS = MakeUnitIdentifier<M1, S1>;
+        static_assert((std::is_same_v<UIInvert<MS>, UnitLeafVector<UnitBase<"meter", std::ratio<-1>>, UnitBase<"second", std::ratio<-1>>>>));
+        static_assert((std::is_same_v<UIExp<MS, std::ratio<2>>, UnitLeafVector<UnitBase<"meter", std::ratio<2>>, UnitBase<"second", std::ratio<2>>>>));
+        static_assert((std::is_same_v<UIMult<MS, UIInvert<MS>>, EmptyUid>));
+        static_assert((std::is_same_v<UIDivide<MS, MakeUnitIdentifier<S1>>, MakeUnitIdentifier<M1>>));
+        static_assert((UnitIdentifier<MS>));
+        static_assert((!UnitIdentifier<UnitLeafVector<S1, M1>>));
+    }
+
     // /** -- Run constructor tests --  */
     std::cout
         << "Running constructor tests" << std::endl;
@@ -1230,6 +2748,101 @@ int main()
         assert((Vector3<double>{3.0, 2.0, 1.0}.Cross(Vector3<double>{1.0, 2.0, 3.0}) == Vector3<double>{4.0, -8.0, 4.0}));
     }
 
+    std::cout << "Running batch kernel tests" << std::endl;
+    // Unit checking
+    {
+        using MeterPerSecond = DivideType<Meter, Second>;
+        static_assert((BatchElement<double>));
+        static_assert((BatchElement<Meter>));
+        static_assert((BatchElement<Vector3<Kilometer>>));
+        static_assert((!BatchElement<float>));
+        static_assert((!BatchElement<Vector2<std::string>>));
+
+        static_assert((CanBatchAddScaled<Vector2<Meter>, Vector2<MeterPerSecond>, Second>));
+        static_assert((CanBatchAddScaled<Vector2<Kilometer>, Vector2<MeterPerSecond>, Second>));
+        static_assert((CanBatchAddScaled<Meter, Meter, double>));
+        static_assert((CanBatchAddScaled<Vector2<double>, Vector2<double>, double>));
+        static_assert((!CanBatchAddScaled<Vector2<Meter>, Vector2<MeterPerSecond>, Meter>));
+        static_assert((!CanBatchAddScaled<Vector2<Meter>, Vector2<Meter>, Second>));
+        static_assert((!CanBatchAddScaled<Vector2<Meter>, Vector3<Meter>, double>));
+    }
+    // BatchAddScaled / BatchIntegrate match element-wise operators, including odd tails and ratios
+    {
+        using MeterPerSecond = DivideType<Meter, Second>;
+        constexpr size_t count = 11;
+
+        std::vector<Vector3<Meter>> pos, refPos;
+        std::vector<Vector3<MeterPerSecond>> vel, refVel;
+        std::vector<Vector3<MeterPerSecond_2>> acc;
+        for (size_t i = 0; i < count; i++)
+        {
+            double f = static_cast<double>(i);
+            pos.push_back({f, -f, 2 * f});
+            vel.push_back({0.5 * f, 1, -0.25 * f});
+            acc.push_back({1, -2, 0.125 * f});
+        }
+        refPos = pos;
+        refVel = vel;
+
+        Second dt{0.5};
+        BatchIntegrate(pos, vel, acc, dt);
+        for (size_t i = 0; i < count; i++)
+        {
+            refVel[i] += acc[i] * dt;
+            refPos[i] += refVel[i] * dt;
+            assert((vel[i] == refVel[i]));
+            assert((pos[i] == refPos[i]));
+        }
+
+        std::vector<Vector3<Kilometer>> kmPos(count, Vector3<Kilometer>{1, 2, 3});
+        std::vector<Vector3<Kilometer>> refKmPos = kmPos;
+        BatchAddScaled(kmPos, vel, dt);
+        for (size_t i = 0; i < count; i++)
+        {
+            refKmPos[i] += vel[i] * dt;
+            assert((kmPos[i] == refKmPos[i]));
+        }
+
+        std::array<double, 5> a{1, 2, 3, 4, 5};
+        std::array<double, 5> b{1, 1, 1, 1, 1};
+        BatchAddScaled(std::span{a}, b, 2.0);
+        assert((a == std::array<double, 5>{3, 4, 5, 6, 7}));
+
+        std::vector<Meter> tooShort(3);
+        bool threw = false;
+        try
+        {
+            BatchAddScaled(tooShort, std::vector<Meter>(4), 1.0);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+    // BatchSinCos matches std::sin/std::cos to about an ulp, in every quadrant and across the SIMD/tail split
+    {
+        std::vector<double> angles;
+        for (int i = -400; i <= 400; i++)
+        {
+            angles.push_back(i * 0.0371);
+        }
+        angles.push_back(0.0);
+        angles.push_back(M_PI);
+        angles.push_back(-M_PI / 2);
+        angles.push_back(1e5 + 0.25);
+
+        std::vector<double> sines(angles.size());
+        std::vector<double> cosines(angles.size());
+        BatchSinCos(angles, sines, cosines);
+        for (size_t i = 0; i < angles.size(); i++)
+        {
+            assert((std::abs(sines[i] - std::sin(angles[i])) <= 2e-16));
+            assert((std::abs(cosines[i] - std::cos(angles[i])) <= 2e-16));
+        }
+        assert((sines[angles.size() - 4] == 0.0 && cosines[angles.size() - 4] == 1.0));
+    }
+
     // ------------------------------------------------------------
     // Run Matrix tests
     // ------------------------------------------------------------
@@ -1339,6 +2952,68 @@ int main()
         assert((!IsMultDefined<Matrix<2, 3, double>, Matrix<4, 2, double>>));
     }
 
+    std::cout << "Running SIMD specialization tests" << std::endl;
+    // Layout
+    {
+        static_assert((SimdLane<float> && SimdLane<double> && SimdLane<Meter> && SimdLane<fMeter>));
+        static_assert((!SimdLane<int> && !SimdLane<Vector<1, double>> && !SimdLane<std::string>));
+        static_assert((alignof(Vector4<float>) == 16 && alignof(Vector4<fMeter>) == 16));
+        static_assert((alignof(Vector4<double>) == 32 && alignof(Vector4<Kilometer>) == 32));
+        static_assert((alignof(Matrix4<float>) == 16 && alignof(Matrix4<double>) == 32));
+        static_assert((sizeof(Vector4<double>) == 4 * sizeof(double) && sizeof(Matrix4<float>) == 16 * sizeof(float)));
+        static_assert((alignof(Vector3<double>) == alignof(double) && alignof(Matrix3<double>) == alignof(double)));
+    }
+    // Results match the element-wise definitions exactly, for plain and unit-wrapped lanes
+    {
+        auto checkVector = []<typename T>(Vector4<T> a, Vector4<T> b)
+        {
+            Vector4<T> sum = a + b;
+            Vector4<T> diff = a - b;
+            auto prod = a * b;
+            auto scaled = a * b[1];
+            auto lscaled = b[2] * a;
+            for (size_t i = 0; i < 4; i++)
+            {
+                assert((sum[i] == a[i] + b[i]));
+                assert((diff[i] == a[i] - b[i]));
+                assert((prod[i] == a[i] * b[i]));
+                assert((scaled[i] == a[i] * b[1]));
+                assert((lscaled[i] == b[2] * a[i]));
+            }
+        };
+        checkVector(Vector4<float>{1.5f, -2.25f, 3.0f, 0.1f}, Vector4<float>{0.3f, 4.0f, -1.0f, 7.7f});
+        checkVector(Vector4<double>{1.5, -2.25, 3.0, 0.1}, Vector4<double>{0.3, 4.0, -1.0, 7.7});
+        checkVector(Vector4<Meter>{1.5, -2.25, 3.0, 0.1}, Vector4<Meter>{0.3, 4.0, -1.0, 7.7});
+        checkVector(Vector4<fMeter>{1.5f, -2.25f, 3.0f, 0.1f}, Vector4<fMeter>{0.3f, 4.0f, -1.0f, 7.7f});
+
+        auto checkMatrix = []<typename A, typename B>(Matrix4<A> a, Matrix4<B> b, Vector4<B> v)
+        {
+            auto mv = a * v;
+            auto mm = a * b;
+            for (size_t i = 0; i < 4; i++)
+            {
+                assert((mv[i] == ((a[i][0] * v[0] + a[i][1] * v[1]) + a[i][2] * v[2]) + a[i][3] * v[3]));
+                for (size_t j = 0; j < 4; j++)
+                {
+                    assert((mm[i][j] == ((a[i][0] * b[0][j] + a[i][1] * b[1][j]) + a[i][2] * b[2][j]) + a[i][3] * b[3][j]));
+                }
+            }
+        };
+        checkMatrix(Matrix4<float>{{1.f, 2.f, 3.f, 4.f}, {-5.f, 6.f, 7.f, 8.f}, {9.f, 10.5f, 11.f, 12.f}, {13.f, 14.f, -15.f, 0.25f}},
+                    Matrix4<float>{{0.5f, 1.f, 0.f, 2.f}, {3.f, -1.f, 4.f, 1.f}, {5.f, 9.f, 2.f, 6.f}, {5.f, 3.f, 5.f, 8.f}},
+                    Vector4<float>{0.1f, -0.2f, 0.3f, 0.4f});
+        checkMatrix(Matrix4<double>{{1., 2., 3., 4.}, {-5., 6., 7., 8.}, {9., 10.5, 11., 12.}, {13., 14., -15., 0.25}},
+                    Matrix4<double>{{0.5, 1., 0., 2.}, {3., -1., 4., 1.}, {5., 9., 2., 6.}, {5., 3., 5., 8.}},
+                    Vector4<double>{0.1, -0.2, 0.3, 0.4});
+        checkMatrix(Matrix4<Meter>{{1., 2., 3., 4.}, {-5., 6., 7., 8.}, {9., 10.5, 11., 12.}, {13., 14., -15., 0.25}},
+                    Matrix4<Kilometer>{{0.5, 1., 0., 2.}, {3., -1., 4., 1.}, {5., 9., 2., 6.}, {5., 3., 5., 8.}},
+                    Vector4<Kilometer>{0.1, -0.2, 0.3, 0.4});
+
+        // Unit types are still carried through the fast path
+        assert((std::is_same_v<decltype(Matrix4<Meter>{} * Vector4<Kilometer>{}), Vector4<MultiplyType<Meter, Kilometer>>>));
+        assert((Matrix4<Meter>::Identity() * Vector4<Meter>{1, 2, 3, 4} == Vector4<Meter_2>{1, 2, 3, 4}));
+    }
+
     std::cout << "Running compound assignment tests" << std::endl;
     // Addition assignment
     {
@@ -1524,6 +3199,105 @@ int main()
                 Matrix<4, 4, double>{{1., 0., 0., 0.}, {0., 0.5, 1.5, 0.}, {0., 0., 1., 0.}, {0., 0., 0., 1.}}));
     }
 
+    std::cout << "Running LU decomposition tests" << std::endl;
+    {
+        auto near = [](double a, double b)
+        { return std::abs(a - b) < 0.00000001; };
+
+        // Tridiagonal {1, 2, 1} matrices have determinant N + 1
+        Matrix<5, 5, double> tri5 = {{2, 1, 0, 0, 0}, {1, 2, 1, 0, 0}, {0, 1, 2, 1, 0}, {0, 0, 1, 2, 1}, {0, 0, 0, 1, 2}};
+        assert((near(Det(tri5), 6)));
+
+        // Rows out of order force pivoting and flip the sign
+        Matrix<6, 6, double> tri6 = {{0, 1, 2, 1, 0, 0}, {1, 2, 1, 0, 0, 0}, {2, 1, 0, 0, 0, 0},
+                                     {0, 0, 1, 2, 1, 0}, {0, 0, 0, 1, 2, 1}, {0, 0, 0, 0, 1, 2}};
+        assert((near(Det(tri6), -7)));
+
+        // P * A = L * U
+        LUDecomposition<6, double> lu = LUDecompose(tri6);
+        assert((!lu.singular));
+        Matrix<6, 6, double> product = lu.lower * lu.upper;
+        for (size_t i = 0; i < 6; i++)
+        {
+            for (size_t j = 0; j < 6; j++)
+            {
+                assert((near(product.At(i, j), tri6.At(lu.perm[i], j))));
+            }
+        }
+
+        // A * Inv(A) = I
+        Matrix<6, 6, double> identity = tri6 * Inv(tri6);
+        for (size_t i = 0; i < 6; i++)
+        {
+            for (size_t j = 0; j < 6; j++)
+            {
+                assert((near(identity.At(i, j), i == j ? 1 : 0)));
+            }
+        }
+
+        // Solve without forming the inverse
+        Vector<5, double> x = Solve(tri5, Vector<5, double>{4, 8, 12, 16, 14});
+        for (size_t i = 0; i < 5; i++)
+        {
+            assert((near(x[i], static_cast<double>(i + 1))));
+        }
+
+        // Solve also works below LU_MIN_SIZE, and agrees with the cofactor inverse
+        Matrix<3, 3, double> small = {{4, 7, 2}, {3, 6, 1}, {2, 5, 1}};
+        Vector<3, double> smallB = {1, 2, 3};
+        Vector<3, double> viaInv = Inv(small) * smallB;
+        Vector<3, double> viaSolve = Solve(small, smallB);
+        for (size_t i = 0; i < 3; i++)
+        {
+            assert((near(viaInv[i], viaSolve[i])));
+        }
+
+        // Singular matrices
+        Matrix<6, 6, double> singular = {{1, 2, 3, 4, 5, 6}, {2, 4, 6, 8, 10, 12}, {0, 1, 0, 1, 0, 1},
+                                          {1, 0, 1, 0, 1, 0}, {3, 1, 4, 1, 5, 9}, {2, 7, 1, 8, 2, 8}};
+        assert((Det(singular) == 0));
+        assert((Inv(singular) == Matrix<6, 6, double>::Zero()));
+        bool threw = false;
+        try
+        {
+            Solve(singular, Vector<6, double>{1, 1, 1, 1, 1, 1});
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        // Unit typing is preserved
+        Matrix<6, 6, Meter> tri6m = {{2, 1, 0, 0, 0, 0}, {1, 2, 1, 0, 0, 0}, {0, 1, 2, 1, 0, 0},
+                                     {0, 0, 1, 2, 1, 0}, {0, 0, 0, 1, 2, 1}, {0, 0, 0, 0, 1, 2}};
+        static_assert((std::is_same_v<decltype(Det(tri6m)), UnitExpI<Meter, 6>>));
+        assert((Det(tri6m) == UnitExpI<Meter, 6>{7}));
+
+        static_assert((std::is_same_v<decltype(Inv(tri6m)), Matrix<6, 6, InvertType<Meter>>>));
+        Matrix<6, 6, double> identityM = tri6m * Inv(tri6m);
+        for (size_t i = 0; i < 6; i++)
+        {
+            for (size_t j = 0; j < 6; j++)
+            {
+                assert((near(identityM.At(i, j), i == j ? 1 : 0)));
+            }
+        }
+
+        Vector<6, Meter_2> area = {4, 8, 12, 16, 20, 17};
+        Vector<6, Meter> xm = Solve(tri6m, area);
+        for (size_t i = 0; i < 6; i++)
+        {
+            assert((xm[i] == Meter{static_cast<double>(i + 1)}));
+        }
+
+        // Ratios carry through: Kilometer^2 / Meter is stored in units of 1000 m
+        Matrix<6, 6, Meter> idM = Matrix<6, 6, Meter>::Identity();
+        Vector<6, Kilometer_2> kmArea = {1, 2, 3, 4, 5, 6};
+        auto xkm = Solve(idM, kmArea);
+        assert((xkm[2] == Kilometer_2{3} / Meter{1}));
+    }
+
     std::cout << "------ BEGIN TESTING ACTOR AND COLLISION ------" << std::endl;
 
     TestActorInitialization();
@@ -1533,6 +3307,30 @@ int main()
     TestCollisionDetection();
     TestActorCollisionResponse();
     TestActorRotationAfterCollision();
+    TestAABBTree();
+    TestActorIncrementalRotation();
+    TestActorUpdateAll();
+    TestSweepAABB();
+    TestActorContinuousCollision();
+    TestAABBSet();
+    TestActorTreeRegistration();
+    TestSweepAndPrune();
+    TestActorSweepAndPruneContacts();
+    TestUnitTypedActor();
+    TestPhysicsWorld();
+
+    std::cout << "------ BEGIN TESTING GAME ------" << std::endl;
+
+    TestEntityPool();
+    TestChildList();
+    TestKinematicBodyRelease();
+    TestGameLoop();
+    TestThreadPool();
+    TestRunBatchDeterminism();
+    TestRng();
+    TestSpatialHash();
+    TestAsciiGraphicsReplay();
+    TestSpriteStampAcrossSeam();
 
     std::cout << "All tests passed successfully.\n";
 
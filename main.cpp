@@ -1,11 +1,115 @@
 #include "AsteroidGame.h"
+#include "HeadlessGame.h"
 #include "JumpGame.h"
+#include <charconv>
+#include <cstring>
 #include <iostream>
 
 #include "Keypress.h"
 
-int main()
+/** @brief Parse a whole command-line argument as an unsigned count */
+bool ParseCount(const char *arg, uint64_t &out)
 {
+    const char *end = arg + strlen(arg);
+    auto [ptr, ec] = std::from_chars(arg, end, out);
+    return ec == std::errc{} && ptr == end && ptr != arg;
+}
+
+int PrintUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << "\n"
+              << "       " << program << " --headless <ticks> [game]\n"
+              << "       " << program << " --batch <worlds> <ticks> [game] [threads]" << std::endl;
+    return 1;
+}
+
+/**
+ * Headless mode: `main --headless <ticks> [game]` steps the game as fast as
+ * possible with null graphics and prints the throughput
+ */
+int RunHeadlessGame(uint64_t ticks, const std::string &name)
+{
+    HeadlessStats stats;
+    if (name == "asteroid")
+    {
+        stats = RunHeadless<AsteroidGame>(ticks);
+    }
+    else if (name == "jump")
+    {
+        stats = RunHeadless<JumpGame>(ticks);
+    }
+    else
+    {
+        std::cerr << "Unknown game: " << name << std::endl;
+        return 1;
+    }
+
+    std::cout << name << ": " << stats.ticks << " ticks in " << stats.seconds << " s ("
+              << stats.TicksPerSecond() << " ticks/s)" << std::endl;
+    return 0;
+}
+
+/**
+ * Batch mode: `main --batch <worlds> <ticks> [game] [threads]` runs independent
+ * seeded worlds in parallel and prints the aggregate throughput
+ */
+int RunBatchGame(size_t worlds, uint64_t ticks, const std::string &name, size_t threads)
+{
+    ThreadPool pool{threads};
+    BatchStats stats;
+    if (name == "asteroid")
+    {
+        std::vector<double> points(worlds);
+        stats = RunBatch<AsteroidGame>(pool, worlds, ticks, [&points](size_t i, AsteroidGame &game)
+                                       { points[i] = game.points; });
+
+        double total = 0;
+        for (double p : points)
+        {
+            total += p;
+        }
+        std::cout << "mean points: " << (worlds > 0 ? total / worlds : 0) << std::endl;
+    }
+    else if (name == "jump")
+    {
+        stats = RunBatch<JumpGame>(pool, worlds, ticks);
+    }
+    else
+    {
+        std::cerr << "Unknown game: " << name << std::endl;
+        return 1;
+    }
+
+    std::cout << name << ": " << stats.worlds << " worlds x " << stats.ticksPerWorld << " ticks on "
+              << pool.Size() << " threads in " << stats.seconds << " s ("
+              << stats.TicksPerSecond() << " ticks/s)" << std::endl;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "--batch") == 0)
+    {
+        uint64_t worlds = 0;
+        uint64_t ticks = 0;
+        uint64_t threads = ThreadPool::DefaultThreads();
+        if (argc < 4 || argc > 6 || !ParseCount(argv[2], worlds) || !ParseCount(argv[3], ticks) ||
+            (argc >= 6 && !ParseCount(argv[5], threads)))
+        {
+            return PrintUsage(argv[0]);
+        }
+        return RunBatchGame(worlds, ticks, argc >= 5 ? argv[4] : "asteroid", threads);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--headless") == 0)
+    {
+        uint64_t ticks = 0;
+        if (argc < 3 || argc > 4 || !ParseCount(argv[2], ticks))
+        {
+            return PrintUsage(argv[0]);
+        }
+        return RunHeadlessGame(ticks, argc >= 4 ? argv[3] : "asteroid");
+    }
+
     // using Meter = TypeAtomic<double, "meter">;
     // Meter val{10};
     // val = 0.2;
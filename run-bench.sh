@@ -0,0 +1 @@
+make bench && ./_Bench/bench && make bench-instr